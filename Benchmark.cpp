@@ -0,0 +1,674 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: Benchmark.cpp
+Purpose: Benchmarks every OrdListClass operation over several key distributions and list sizes so that
+		regressions can be tracked between releases.
+Input: Command line options (all optional)
+		--sizes 1000,10000,...		list sizes to run (default 1000,10000,100000,1000000)
+		--full						run every decade from 1K to 100M
+		--dists seq,rev,uniform,zipf	key distributions to run (default all four)
+		--modes plain,scapegoat,splay	balance modes of the list under test (default plain)
+		--probes N					lookups/deletes per case (default 1000000, capped at the list size)
+		--max-chain N				largest list built from sorted (seq/rev) input (default 20000)
+		--format csv|json			output format (default csv)
+		--out fileName				write the report to fileName instead of the console
+		--tmp fileName				scratch file for the file operations (default bench_printfile.tmp in the
+									system temp directory)
+Output: One row per (mode, distribution, size, operation) with ops, seconds, ns/op, ops/s and the change in resident
+		set size over the operation in KB. The peak RSS of the whole run is reported on the console at the end
+Assumptions: seq and rev insert keys in sorted order, which leaves a chain behind in plain and splay mode. Those
+		cases are O(n^2) and recurse once per level in rFind, so sizes above --max-chain are reported as skipped
+		(scapegoat mode keeps the tree balanced and runs every size).
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "OrdListADT.h"
+#include "ItemType.h"
+#include "Exceptions.h"
+
+using namespace std;
+
+//one measured (mode, distribution, size, operation)
+struct ResultType
+{
+	string mode;		//balance mode of the list
+	string dist;		//key distribution
+	long long size;		//list size
+	string op;			//operation measured
+	long long ops;		//operations (or items) processed
+	double seconds;		//wall time
+	long rssDeltaKB;	//resident set size after the operation less the size before it
+	string status;		//ok or skipped
+};
+
+//start of a measured operation
+struct MarkType
+{
+	chrono::steady_clock::time_point time;	//when the work began
+	long rssKB;								//resident set size then
+};
+
+//command line settings
+struct OptionsType
+{
+	vector<long long> sizes;
+	vector<string> dists;
+	vector<string> modes;
+	long long probes;
+	long long maxChain;
+	string format;
+	string outName;
+	string tmpName;
+};
+
+//Zipfian generator over ranks [0, n) (Gray et al., "Quickly generating billion-record synthetic databases")
+class ZipfClass
+{
+public:
+	ZipfClass(long long n, double theta, unsigned seed);
+	long long Next();
+
+private:
+	long long n;
+	double theta;
+	double alpha;
+	double zetan;
+	double eta;
+	mt19937_64 rng;
+	uniform_real_distribution<double> unit;
+};
+
+OptionsType ParseOptions(int argc, char* argv[]);
+long PeakRssKB();
+long CurrentRssKB();
+MarkType Mark();
+vector<long long> MakeOrder(const string& dist, long long n, unsigned seed);
+vector<long long> MakeProbes(const string& dist, long long n, long long count, unsigned seed);
+void RunCase(const string& mode, const string& dist, long long n, const OptionsType& options, vector<ResultType>& results);
+void Record(vector<ResultType>& results, const string& mode, const string& dist, long long n, const string& op,
+			long long ops, const MarkType& start);
+void WriteCsv(const vector<ResultType>& results, ostream& out);
+void WriteJson(const vector<ResultType>& results, ostream& out);
+void DisplayFile(const ItemType&, ofstream&);
+
+
+int main(int argc, char* argv[])
+{
+	OptionsType options = ParseOptions(argc, argv);
+	vector<ResultType> results;
+
+	for (size_t m = 0; m < options.modes.size(); ++m)
+	{
+		for (size_t d = 0; d < options.dists.size(); ++d)
+		{
+			for (size_t s = 0; s < options.sizes.size(); ++s)
+			{
+				RunCase(options.modes[m], options.dists[d], options.sizes[s], options, results);
+				cerr << options.modes[m] << " " << options.dists[d] << " " << options.sizes[s] << " done" << endl;
+
+			}//end for
+
+		}//end for
+
+	}//end for
+
+	if (options.outName.empty())
+	{
+		if (options.format == "json")
+			WriteJson(results, cout);
+		else
+			WriteCsv(results, cout);
+
+	}//end if
+
+	else
+	{
+		ofstream outdat(options.outName);
+		if (options.format == "json")
+			WriteJson(results, outdat);
+		else
+			WriteCsv(results, outdat);
+
+	}//end else
+
+	cerr << "peak RSS " << PeakRssKB() << " KB" << endl;
+	remove(options.tmpName.c_str());
+	return 0;
+
+}//end main
+
+
+//Pre: argc and argv are the arguments of main
+//Post: returns the settings given on the command line, defaults for everything else
+OptionsType ParseOptions(/*in*/int argc,		//number of arguments
+						 /*in*/char* argv[])	//arguments
+{
+	OptionsType options;
+	long long defaultSizes[] = { 1000, 10000, 100000, 1000000 };
+	string defaultDists[] = { "seq", "rev", "uniform", "zipf" };
+
+	options.sizes.assign(defaultSizes, defaultSizes + 4);
+	options.dists.assign(defaultDists, defaultDists + 4);
+	options.modes.push_back("plain");
+	options.probes = 1000000;
+	options.maxChain = 20000;
+	options.format = "csv";
+	try
+	{
+		options.tmpName = (filesystem::temp_directory_path() / "bench_printfile.tmp").string();
+
+	}//end try
+
+	catch (filesystem::filesystem_error&)
+	{
+		//no temp directory: fall back to the working directory
+		options.tmpName = "bench_printfile.tmp";
+
+	}//end catch
+
+	for (int i = 1; i < argc; ++i)
+	{
+		string arg = argv[i];
+		string value = (i + 1 < argc) ? argv[i + 1] : "";
+		string field;
+
+		if (arg == "--full")
+		{
+			options.sizes.clear();
+			for (long long n = 1000; n <= 100000000; n *= 10)
+			{
+				options.sizes.push_back(n);
+
+			}//end for
+
+			continue;
+
+		}//end if
+
+		++i;
+		if (arg == "--sizes")
+		{
+			stringstream list(value);
+			options.sizes.clear();
+			while (getline(list, field, ','))
+			{
+				options.sizes.push_back(atoll(field.c_str()));
+
+			}//end while
+
+		}//end if
+
+		else if (arg == "--dists")
+		{
+			stringstream list(value);
+			options.dists.clear();
+			while (getline(list, field, ','))
+			{
+				options.dists.push_back(field);
+
+			}//end while
+
+		}//end else if
+
+		else if (arg == "--modes")
+		{
+			stringstream list(value);
+			options.modes.clear();
+			while (getline(list, field, ','))
+			{
+				options.modes.push_back(field);
+
+			}//end while
+
+		}//end else if
+
+		else if (arg == "--probes")
+			options.probes = atoll(value.c_str());
+		else if (arg == "--max-chain")
+			options.maxChain = atoll(value.c_str());
+		else if (arg == "--format")
+			options.format = value;
+		else if (arg == "--out")
+			options.outName = value;
+		else if (arg == "--tmp")
+			options.tmpName = value;
+		else
+		{
+			cerr << "unknown option " << arg << endl;
+			exit(1);
+
+		}//end else
+
+	}//end for
+
+	return options;
+
+}//end ParseOptions
+
+
+//Pre: none
+//Post: returns the peak resident set size of the process so far, in KB
+long PeakRssKB()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return (long)(counters.PeakWorkingSetSize / 1024);
+#else
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss;
+#endif
+
+}//end PeakRssKB
+
+
+//Pre: none
+//Post: returns the resident set size of the process right now, in KB (0 if it can not be read)
+long CurrentRssKB()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+	return (long)(counters.WorkingSetSize / 1024);
+#else
+	long pages = 0;
+	long resident = 0;
+	ifstream statm("/proc/self/statm");
+
+	if (!(statm >> pages >> resident))
+	{
+		return 0;
+
+	}//end if
+
+	return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+
+}//end CurrentRssKB
+
+
+//Pre: none
+//Post: returns the time and resident set size at the start of an operation to the caller
+MarkType Mark()
+{
+	MarkType temp;
+
+	temp.rssKB = CurrentRssKB();
+	temp.time = chrono::steady_clock::now();
+	return temp;
+
+}//end Mark
+
+
+//Pre: n > 0, 0 < theta < 1
+//Post: a generator of ranks in [0, n), rank 0 the most likely, has been created
+ZipfClass::ZipfClass(/*in*/long long n,		//number of ranks
+					 /*in*/double theta,	//skew
+					 /*in*/unsigned seed)	//random seed
+	: n(n), theta(theta), rng(seed), unit(0.0, 1.0)
+{
+	double zeta2 = 1.0 + pow(0.5, theta);
+
+	zetan = 0.0;
+	for (long long i = 1; i <= n; ++i)
+	{
+		zetan += 1.0 / pow((double)i, theta);
+
+	}//end for
+
+	alpha = 1.0 / (1.0 - theta);
+	eta = (1.0 - pow(2.0 / (double)n, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+
+}//end ZipfClass
+
+
+//Pre: ZipfClass has been instantiated
+//Post: returns the next rank to the caller
+long long ZipfClass::Next()
+{
+	double u = unit(rng);
+	double uz = u * zetan;
+
+	if (uz < 1.0)
+		return 0;
+	if (uz < 1.0 + pow(0.5, theta))
+		return (n > 1) ? 1 : 0;
+
+	long long rank = (long long)((double)n * pow(eta * u - eta + 1.0, alpha));
+	return min(rank, n - 1);
+
+}//end Next
+
+
+//Pre: n > 0
+//Post: returns the ranks 0..n-1 in the order dist inserts them. seq ascending, rev descending, uniform and
+//		zipf a random permutation (zipf differs from uniform in its probes, not in the shape of the tree)
+vector<long long> MakeOrder(/*in*/const string& dist,	//key distribution
+							/*in*/long long n,			//list size
+							/*in*/unsigned seed)		//random seed
+{
+	vector<long long> order(n);
+
+	for (long long i = 0; i < n; ++i)
+	{
+		order[i] = (dist == "rev") ? n - 1 - i : i;
+
+	}//end for
+
+	if (dist == "uniform" || dist == "zipf")
+	{
+		shuffle(order.begin(), order.end(), mt19937_64(seed));
+
+	}//end if
+
+	return order;
+
+}//end MakeOrder
+
+
+//Pre: n > 0, count >= 0
+//Post: returns count ranks in [0, n) to probe. seq and rev walk the ranks in order, uniform draws them evenly
+//		and zipf draws them with theta 0.99 after scattering the hot ranks over the key space
+vector<long long> MakeProbes(	/*in*/const string& dist,	//key distribution
+								/*in*/long long n,			//list size
+								/*in*/long long count,		//number of probes
+								/*in*/unsigned seed)		//random seed
+{
+	vector<long long> probes(count);
+	mt19937_64 rng(seed);
+
+	if (dist == "zipf")
+	{
+		ZipfClass zipf(n, 0.99, seed);
+		vector<long long> scatter = MakeOrder("uniform", n, seed + 1);
+
+		for (long long i = 0; i < count; ++i)
+		{
+			probes[i] = scatter[zipf.Next()];
+
+		}//end for
+
+	}//end if
+
+	else if (dist == "uniform")
+	{
+		uniform_int_distribution<long long> pick(0, n - 1);
+		for (long long i = 0; i < count; ++i)
+		{
+			probes[i] = pick(rng);
+
+		}//end for
+
+	}//end else if
+
+	else
+	{
+		for (long long i = 0; i < count; ++i)
+		{
+			probes[i] = (dist == "rev") ? n - 1 - (i % n) : (i % n);
+
+		}//end for
+
+	}//end else
+
+	return probes;
+
+}//end MakeProbes
+
+
+//Pre: start was taken right before the measured work
+//Post: a row for op has been appended to results
+void Record(/*inout*/vector<ResultType>& results,				//report
+			/*in*/const string& mode,							//balance mode
+			/*in*/const string& dist,							//key distribution
+			/*in*/long long n,									//list size
+			/*in*/const string& op,								//operation measured
+			/*in*/long long ops,								//operations processed
+			/*in*/const MarkType& start)						//when the work began
+{
+	ResultType row;
+
+	row.seconds = chrono::duration<double>(chrono::steady_clock::now() - start.time).count();
+	row.mode = mode;
+	row.dist = dist;
+	row.size = n;
+	row.op = op;
+	row.ops = ops;
+	row.rssDeltaKB = CurrentRssKB() - start.rssKB;
+	row.status = "ok";
+	results.push_back(row);
+
+}//end Record
+
+
+//Pre: n > 0
+//Post: every operation has been measured on a list in balance mode mode holding n keys inserted and probed as
+//		dist says. rank r is stored as key 2r, so key 2r+1 is always a miss
+void RunCase(	/*in*/const string& mode,			//balance mode
+				/*in*/const string& dist,			//key distribution
+				/*in*/long long n,					//list size
+				/*in*/const OptionsType& options,	//settings
+				/*inout*/vector<ResultType>& results)	//report
+{
+	const char* ops[] = { "Insert", "FindHit", "FindMiss", "Scan", "Assign", "Equal", "Union", "PrintFile", "DumpFile", "LoadFile",
+						  "SaveCompressed", "LoadCompressed", "Delete", "Clear" };
+
+	//sorted input leaves a chain behind in plain and splay mode, and the cursor walk over a chain is quadratic
+	if (mode != "scapegoat" && (dist == "seq" || dist == "rev") && n > options.maxChain)
+	{
+		for (size_t i = 0; i < sizeof(ops) / sizeof(ops[0]); ++i)
+		{
+			ResultType row = { mode, dist, n, ops[i], 0, 0.0, 0, "skipped" };
+			results.push_back(row);
+
+		}//end for
+
+		return;
+
+	}//end if
+
+	long long count = min(options.probes, n);
+	vector<long long> order = MakeOrder(dist, n, 1);
+	vector<long long> probes = MakeProbes(dist, n, count, 2);
+	OrdListClass list, copy, other;
+	ItemType item;
+	MarkType start;
+	long long found = 0;
+
+	if (mode == "scapegoat")
+		list.SetBalanceMode(BALANCE_SCAPEGOAT, 0.7);
+	else if (mode == "splay")
+		list.SetBalanceMode(BALANCE_SPLAY, 0.7);
+
+	start = Mark();
+	for (long long i = 0; i < n; ++i)
+	{
+		item.key = (KeyType)(2 * order[i]);
+		list.Find(item.key);
+		list.Insert(item);
+
+	}//end for
+	Record(results, mode, dist, n, "Insert", n, start);
+	order.clear();
+	order.shrink_to_fit();
+
+	start = Mark();
+	for (long long i = 0; i < count; ++i)
+	{
+		found += list.Find((KeyType)(2 * probes[i]));
+
+	}//end for
+	Record(results, mode, dist, n, "FindHit", count, start);
+
+	start = Mark();
+	for (long long i = 0; i < count; ++i)
+	{
+		found += list.Find((KeyType)(2 * probes[i] + 1));
+
+	}//end for
+	Record(results, mode, dist, n, "FindMiss", count, start);
+
+	start = Mark();
+	list.FirstPosition();
+	while (!list.EndOfList())
+	{
+		found += list.Retrieve().key & 1;
+		list.NextPosition();
+
+	}//end while
+	Record(results, mode, dist, n, "Scan", n, start);
+
+	start = Mark();
+	copy = list;
+	Record(results, mode, dist, n, "Assign", n, start);
+
+	start = Mark();
+	found += (list == copy);
+	Record(results, mode, dist, n, "Equal", n, start);
+	copy.Clear();
+
+	//the right operand holds half as many keys, all of them misses in list
+	{
+		vector<ItemType> odd((size_t)(n / 2));
+		for (size_t i = 0; i < odd.size(); ++i)
+		{
+			odd[i].key = (KeyType)(4 * i + 1);
+
+		}//end for
+
+		other.BuildFromSorted(odd.data(), (int)odd.size(), false);
+
+	}//end block
+
+	//the sum is built in place, so the row holds operator+ alone and no operator= copy
+	start = Mark();
+	{
+		OrdListClass sum(list + other);
+
+		Record(results, mode, dist, n, "Union", n + n / 2, start);
+
+	}//end block
+	other.Clear();
+
+	start = Mark();
+	list.PrintFile(DisplayFile, options.tmpName);
+	Record(results, mode, dist, n, "PrintFile", n, start);
+
+	start = Mark();
+	list.DumpFile(options.tmpName);
+	Record(results, mode, dist, n, "DumpFile", n, start);
+
+	start = Mark();
+	copy.LoadFile(options.tmpName);
+	Record(results, mode, dist, n, "LoadFile", n, start);
+	found += (list == copy);
+	copy.Clear();
+
+	start = Mark();
+	list.SaveCompressed(options.tmpName);
+	Record(results, mode, dist, n, "SaveCompressed", n, start);
+
+	start = Mark();
+	copy.LoadCompressed(options.tmpName);
+	Record(results, mode, dist, n, "LoadCompressed", n, start);
+	found += (list == copy);
+	copy.Clear();
+
+	start = Mark();
+	for (long long i = 0; i < count; ++i)
+	{
+		if (list.Find((KeyType)(2 * probes[i])))
+		{
+			list.Delete();
+
+		}//end if
+
+	}//end for
+	Record(results, mode, dist, n, "Delete", count, start);
+
+	start = Mark();
+	list.Clear();
+	Record(results, mode, dist, n, "Clear", n, start);
+
+	if (found == -1)
+	{
+		cerr << "unreachable" << endl;	//keeps the probe loops from being optimized away
+
+	}//end if
+
+}//end RunCase
+
+
+//Pre: none
+//Post: results have been written to out as CSV with a header row
+void WriteCsv(	/*in*/const vector<ResultType>& results,	//report
+				/*inout*/ostream& out)						//destination
+{
+	out << "mode,dist,size,op,ops,seconds,ns_per_op,ops_per_sec,rss_delta_kb,status\n";
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const ResultType& row = results[i];
+		double nsPerOp = (row.ops > 0) ? row.seconds * 1e9 / (double)row.ops : 0.0;
+		double perSec = (row.seconds > 0.0) ? (double)row.ops / row.seconds : 0.0;
+
+		out << row.mode << ',' << row.dist << ',' << row.size << ',' << row.op << ',' << row.ops << ',' << row.seconds << ','
+			<< nsPerOp << ',' << perSec << ',' << row.rssDeltaKB << ',' << row.status << '\n';
+
+	}//end for
+
+}//end WriteCsv
+
+
+//Pre: none
+//Post: results have been written to out as a JSON array of objects
+void WriteJson(	/*in*/const vector<ResultType>& results,	//report
+				/*inout*/ostream& out)						//destination
+{
+	out << "[\n";
+
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const ResultType& row = results[i];
+		double nsPerOp = (row.ops > 0) ? row.seconds * 1e9 / (double)row.ops : 0.0;
+		double perSec = (row.seconds > 0.0) ? (double)row.ops / row.seconds : 0.0;
+
+		out << "  {\"mode\": \"" << row.mode << "\", \"dist\": \"" << row.dist << "\", \"size\": " << row.size << ", \"op\": \"" << row.op
+			<< "\", \"ops\": " << row.ops << ", \"seconds\": " << row.seconds << ", \"ns_per_op\": " << nsPerOp
+			<< ", \"ops_per_sec\": " << perSec << ", \"rss_delta_kb\": " << row.rssDeltaKB
+			<< ", \"status\": \"" << row.status << "\"}" << (i + 1 < results.size() ? "," : "") << '\n';
+
+	}//end for
+
+	out << "]\n";
+
+}//end WriteJson
+
+
+void DisplayFile(const ItemType& recToDisplay, ofstream& outdat)
+{
+	outdat << recToDisplay.key << '\n';
+}
@@ -0,0 +1,340 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: CuckooFilter.cpp
+Purpose: Provides the implementation for the cuckoo filter OrdListClass can put in front of Find.
+Input: All input is done via OrdListClass
+Output: none
+Assumptions: A key is never inserted twice without being erased in between, and only keys that were inserted
+		are erased.
+*/
+
+
+#include "CuckooFilter.h"
+#include "KeyHash.h"
+
+#include <cmath>
+
+using namespace std;
+
+static const int MIN_BUCKETS = 4;			//smallest table allocated
+static const double MAX_LOAD = 0.9;			//Insert reports full past this share of the slots
+static const double RESET_LOAD = 0.5;		//share of the slots Reset sizes for, leaves room to grow
+static const int MAX_KICKS = 500;			//evictions tried before Insert gives up
+
+//Pre: 0 < falsePositiveRate < 1
+//Post: a new empty filter has been created. a fingerprint has the fewest bits (4 to 16) that keep the false
+//		positive rate at or below falsePositiveRate: rate ~ 2 * SLOTS_PER_BUCKET / 2^bits. rates below
+//		8 / 65536 (about 0.012%) get 16 bit fingerprints
+CuckooFilterClass::CuckooFilterClass(/*in*/double falsePositiveRate) //largest share of misses answered "maybe"
+{
+	slots = nullptr;
+	numBuckets = 0;
+	count = 0;
+	rate = falsePositiveRate;
+	kickState = 2463534242u;
+
+	bits = 16;
+	if (rate > 0.0 && rate < 1.0)
+	{
+		bits = (int)ceil(log2(2.0 * SLOTS_PER_BUCKET / rate));
+
+	}//end if
+
+	if (bits < 4)
+	{
+		bits = 4;
+
+	}//end if
+
+	if (bits > 16)
+	{
+		bits = 16;
+
+	}//end if
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: the slots have been returned to the freestore
+CuckooFilterClass::~CuckooFilterClass()
+{
+	delete[] slots;
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: returns false to the caller if key is certainly not in the filter, true if it may be. looks at two
+//		buckets, 8 bytes each
+bool CuckooFilterClass::MayContain(/*in*/KeyType key) const //key to test
+{
+	int first;
+	uint16_t fingerprint;
+
+	if (count == 0)
+	{
+		return false;
+
+	}//end if
+
+	Locate(key, first, fingerprint);
+
+	const uint16_t* one = slots + first * SLOTS_PER_BUCKET;
+	const uint16_t* two = slots + AltBucket(first, fingerprint) * SLOTS_PER_BUCKET;
+
+	return (one[0] == fingerprint || one[1] == fingerprint || one[2] == fingerprint || one[3] == fingerprint ||
+			two[0] == fingerprint || two[1] == fingerprint || two[2] == fingerprint || two[3] == fingerprint);
+
+}//end MayContain
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated, key is not in the filter
+//Post: key has been added and true returned. returns false if the filter is too full: some fingerprint
+//		(not necessarily key's) has been lost, so the filter must be Reset and refilled before it is used
+//Exceptions thrown: throws bad_alloc if the filter is still unsized and the freestore is out of memory
+bool CuckooFilterClass::Insert(/*in*/KeyType key) //key to add
+{
+	int bucket;
+	uint16_t fingerprint;
+
+	if (numBuckets == 0)
+	{
+		Reset(MIN_BUCKETS);
+
+	}//end if
+
+	if (count + 1 > MAX_LOAD * numBuckets * SLOTS_PER_BUCKET)
+	{
+		return false;
+
+	}//end if
+
+	Locate(key, bucket, fingerprint);
+
+	if (Place(bucket, fingerprint))
+	{
+		++count;
+		return true;
+
+	}//end if
+
+	bucket = AltBucket(bucket, fingerprint);
+	if (Place(bucket, fingerprint))
+	{
+		++count;
+		return true;
+
+	}//end if
+
+	//both buckets are full: evict a random resident, move it to its other bucket, and so on
+
+	for (int kick = 0; kick < MAX_KICKS; ++kick)
+	{
+		kickState ^= kickState << 13;
+		kickState ^= kickState >> 17;
+		kickState ^= kickState << 5;
+
+		uint16_t& victim = slots[bucket * SLOTS_PER_BUCKET + (int)(kickState % SLOTS_PER_BUCKET)];
+		uint16_t temp = victim;
+		victim = fingerprint;
+		fingerprint = temp;
+
+		bucket = AltBucket(bucket, fingerprint);
+		if (Place(bucket, fingerprint))
+		{
+			++count;
+			return true;
+
+		}//end if
+
+	}//end for
+
+	//fingerprint is homeless and is dropped, so the filter could now answer "no" for a key it holds
+	return false;
+
+}//end Insert
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated, key was inserted and not erased since
+//Post: one fingerprint of key has been removed
+void CuckooFilterClass::Erase(/*in*/KeyType key) //key to remove
+{
+	int first;
+	uint16_t fingerprint;
+
+	if (count == 0)
+	{
+		return;
+
+	}//end if
+
+	Locate(key, first, fingerprint);
+
+	int buckets[2] = { first, AltBucket(first, fingerprint) };
+	for (int b = 0; b < 2; ++b)
+	{
+		for (int i = 0; i < SLOTS_PER_BUCKET; ++i)
+		{
+			if (slots[buckets[b] * SLOTS_PER_BUCKET + i] == fingerprint)
+			{
+				slots[buckets[b] * SLOTS_PER_BUCKET + i] = 0;
+				--count;
+				return;
+
+			}//end if
+
+		}//end for
+
+	}//end for
+
+}//end Erase
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: every fingerprint has been removed. the slots are kept for reuse
+void CuckooFilterClass::Clear()
+{
+	for (int i = 0; i < numBuckets * SLOTS_PER_BUCKET; ++i)
+	{
+		slots[i] = 0;
+
+	}//end for
+
+	count = 0;
+
+}//end Clear
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: the filter is empty and has room for capacity keys at a load that keeps inserts cheap
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory, the filter is then unchanged
+void CuckooFilterClass::Reset(/*in*/int capacity) //number of keys expected
+{
+	int newBuckets = MIN_BUCKETS;
+
+	while (capacity > RESET_LOAD * newBuckets * SLOTS_PER_BUCKET)
+	{
+		newBuckets *= 2;
+
+	}//end while
+
+	if (newBuckets != numBuckets)
+	{
+		uint16_t* temp = new uint16_t[newBuckets * SLOTS_PER_BUCKET];		//throws before anything has changed
+		delete[] slots;
+		slots = temp;
+		numBuckets = newBuckets;
+
+	}//end if
+
+	Clear();
+
+}//end Reset
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: returns the number of keys in the filter to the caller
+int CuckooFilterClass::ReturnCount() const
+{
+	return count;
+
+}//end ReturnCount
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: returns the false positive rate the fingerprints are sized for
+double CuckooFilterClass::ReturnFalsePositiveRate() const
+{
+	return rate;
+
+}//end ReturnFalsePositiveRate
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated
+//Post: returns the number of bytes held by the slots to the caller
+long long CuckooFilterClass::ReturnBytes() const
+{
+	return (long long)numBuckets * SLOTS_PER_BUCKET * (long long)sizeof(uint16_t);
+
+}//end ReturnBytes
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated and sized
+//Post: returns the first bucket and the fingerprint (never 0) of key
+void CuckooFilterClass::Locate(	/*in*/KeyType key,				//key to hash
+								/*out*/int& bucket,				//first bucket of key
+								/*out*/uint16_t& fingerprint) const	//fingerprint of key
+{
+	//low bits pick the bucket, high bits make the fingerprint, so the two are independent
+
+	unsigned long long hash = Mix((unsigned long long)key);
+
+	bucket = (int)(hash & (unsigned long long)(numBuckets - 1));
+	fingerprint = (uint16_t)((hash >> 48) & ((1u << bits) - 1));
+	if (fingerprint == 0)
+	{
+		fingerprint = 1;
+
+	}//end if
+
+}//end Locate
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated and sized
+//Post: returns the other bucket fingerprint may live in. AltBucket(AltBucket(b, f), f) == b
+int CuckooFilterClass::AltBucket(	/*in*/int bucket,					//one bucket of fingerprint
+									/*in*/uint16_t fingerprint) const	//fingerprint to place
+{
+	return bucket ^ (int)(Mix(fingerprint) & (unsigned long long)(numBuckets - 1));
+
+}//end AltBucket
+
+
+/*****************************************************************************************************/
+
+//Pre: CuckooFilterClass has been instantiated and sized
+//Post: fingerprint has been put in an empty slot of bucket and true returned. false if the bucket is full
+bool CuckooFilterClass::Place(	/*in*/int bucket,				//bucket to use
+								/*in*/uint16_t fingerprint)		//fingerprint to store
+{
+	uint16_t* slot = slots + bucket * SLOTS_PER_BUCKET;
+
+	for (int i = 0; i < SLOTS_PER_BUCKET; ++i)
+	{
+		if (slot[i] == 0)
+		{
+			slot[i] = fingerprint;
+			return true;
+
+		}//end if
+
+	}//end for
+
+	return false;
+
+}//end Place
@@ -0,0 +1,198 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: CuckooFilter.h
+Purpose: Provides the specification for the cuckoo filter OrdListClass can put in front of Find.
+		The filter answers "is this key maybe in the list?" from a few bytes per key. A "no" is always right, so
+		a Find for a missing key usually returns without touching the tree. A "maybe" is wrong at most about
+		as often as the false positive rate asked for. Unlike a Bloom filter a key can be taken out again, so
+		Delete keeps the filter exact instead of letting it fill up with stale keys.
+		Every key is reduced to a short fingerprint stored in one of two buckets of four slots (partial key
+		cuckoo hashing, Fan et al. 2014). The second bucket is found from the first and the fingerprint alone,
+		so an entry can be moved between its buckets without knowing the key.
+Input: All input is done via OrdListClass
+Output: none
+Assumptions: A key is never inserted twice without being erased in between, and only keys that were inserted
+		are erased. OrdListClass guarantees both, its tree holds no duplicates.
+*/
+
+#ifndef CUCKOO_FILTER
+#define CUCKOO_FILTER
+
+#include <cstdint>
+#include "ItemType.h"
+
+using namespace std;
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+CuckooFilterClass(double falsePositiveRate);
+	a new empty filter has been created with fingerprints long enough for falsePositiveRate
+
+~CuckooFilterClass();
+	the slots have been returned to the freestore
+
+bool MayContain(KeyType key) const;
+	returns false to the caller if key is certainly not in the filter, true if it may be
+
+bool Insert(KeyType key);
+	key has been added. returns false if the filter is full, the filter must then be Reset and refilled
+
+void Erase(KeyType key);
+	one fingerprint of key has been removed
+
+void Clear();
+	every fingerprint has been removed
+
+void Reset(int capacity);
+	the filter is empty and sized for capacity keys
+
+int ReturnCount() const;
+	returns the number of keys in the filter to the caller
+
+double ReturnFalsePositiveRate() const;
+	returns the false positive rate the fingerprints are sized for
+
+long long ReturnBytes() const;
+	returns the number of bytes held by the slots to the caller
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void Locate(KeyType key, int& bucket, uint16_t& fingerprint) const;
+	returns the first bucket and the fingerprint of key
+
+int AltBucket(int bucket, uint16_t fingerprint) const;
+	returns the other bucket fingerprint may live in
+
+bool Place(int bucket, uint16_t fingerprint);
+	fingerprint has been put in an empty slot of bucket. false if the bucket is full
+*/
+
+class CuckooFilterClass
+{
+
+public:
+
+	static const int SLOTS_PER_BUCKET = 4;
+
+	/*****************************************************************************************************/
+
+	//Pre: 0 < falsePositiveRate < 1
+	//Post: a new empty filter has been created. a fingerprint has the fewest bits (4 to 16) that keep the false
+	//		positive rate at or below falsePositiveRate: rate ~ 2 * SLOTS_PER_BUCKET / 2^bits. rates below
+	//		8 / 65536 (about 0.012%) get 16 bit fingerprints
+	CuckooFilterClass(/*in*/double falsePositiveRate); //largest share of misses answered "maybe"
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: the slots have been returned to the freestore
+	~CuckooFilterClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: returns false to the caller if key is certainly not in the filter, true if it may be. looks at two
+	//		buckets, 8 bytes each
+	bool MayContain(/*in*/KeyType key) const; //key to test
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated, key is not in the filter
+	//Post: key has been added and true returned. returns false if the filter is too full: some fingerprint
+	//		(not necessarily key's) has been lost, so the filter must be Reset and refilled before it is used
+	//Exceptions thrown: throws bad_alloc if the filter is still unsized and the freestore is out of memory
+	bool Insert(/*in*/KeyType key); //key to add
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated, key was inserted and not erased since
+	//Post: one fingerprint of key has been removed
+	void Erase(/*in*/KeyType key); //key to remove
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: every fingerprint has been removed. the slots are kept for reuse
+	void Clear();
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: the filter is empty and has room for capacity keys at a load that keeps inserts cheap
+	//Exceptions thrown: throws bad_alloc if the freestore is out of memory, the filter is then unchanged
+	void Reset(/*in*/int capacity); //number of keys expected
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: returns the number of keys in the filter to the caller
+	int ReturnCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: returns the false positive rate the fingerprints are sized for
+	double ReturnFalsePositiveRate() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated
+	//Post: returns the number of bytes held by the slots to the caller
+	long long ReturnBytes() const;
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated and sized
+	//Post: returns the first bucket and the fingerprint (never 0) of key
+	void Locate(/*in*/KeyType key,				//key to hash
+				/*out*/int& bucket,				//first bucket of key
+				/*out*/uint16_t& fingerprint) const;	//fingerprint of key
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated and sized
+	//Post: returns the other bucket fingerprint may live in. AltBucket(AltBucket(b, f), f) == b
+	int AltBucket(	/*in*/int bucket,					//one bucket of fingerprint
+					/*in*/uint16_t fingerprint) const;	//fingerprint to place
+
+	/*****************************************************************************************************/
+
+	//Pre: CuckooFilterClass has been instantiated and sized
+	//Post: fingerprint has been put in an empty slot of bucket and true returned. false if the bucket is full
+	bool Place(	/*in*/int bucket,				//bucket to use
+				/*in*/uint16_t fingerprint);	//fingerprint to store
+
+	/*****************************************************************************************************/
+
+private:
+
+	uint16_t* slots;		//numBuckets * SLOTS_PER_BUCKET fingerprints, 0 marks an empty slot
+	int numBuckets;			//0 or a power of two
+	int count;				//fingerprints stored
+	int bits;				//bits per fingerprint
+	double rate;			//false positive rate asked for
+	unsigned kickState;		//xorshift state picking which fingerprint to evict
+
+	//no copies, OrdListClass builds a fresh filter for a copied list
+	CuckooFilterClass(const CuckooFilterClass&);
+	void operator=(const CuckooFilterClass&);
+
+};
+
+#endif
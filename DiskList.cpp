@@ -0,0 +1,1013 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: DiskList.cpp
+Purpose: Provides the implementation for the ordered list that keeps its items on disk, as a B+ tree of pages.
+Input: All input is done via client
+Output: Supports a function pointer containing a output file stream. Client handles formatting of all print
+		functions. The pages live in a scratch file that is removed with the list.
+Assumptions: ItemType can be copied byte for byte to and from a page. One thread uses the list.
+*/
+
+
+#include "DiskList.h"
+#include "Exceptions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+//first bytes of every page
+struct PageHeader
+{
+	int leaf;			//1 for a leaf, 0 for an inner page
+	int count;			//items of a leaf, keys of an inner page
+	PageId next;		//next leaf in key order, NO_PAGE after the last (leaves only)
+};
+
+//items a leaf holds, and keys an inner page holds (it has one child more than keys)
+static const int LEAF_CAPACITY = (int)((PageCacheClass::PAGE_SIZE - sizeof(PageHeader)) / sizeof(ItemType));
+static const int INNER_CAPACITY = (int)((PageCacheClass::PAGE_SIZE - sizeof(PageHeader) - sizeof(PageId)) /
+										(sizeof(KeyType) + sizeof(PageId)));
+
+//a leaf, its items sorted by key
+struct LeafPage
+{
+	PageHeader header;
+	ItemType items[LEAF_CAPACITY];
+};
+
+//an inner page. children[i] holds the keys below keys[i], children[i + 1] the keys from keys[i] up
+struct InnerPage
+{
+	PageHeader header;
+	KeyType keys[INNER_CAPACITY];
+	PageId children[INNER_CAPACITY + 1];
+};
+
+static_assert(sizeof(LeafPage) <= PageCacheClass::PAGE_SIZE && sizeof(InnerPage) <= PageCacheClass::PAGE_SIZE,
+			  "a page must fit in PAGE_SIZE bytes");
+static_assert(is_trivially_copyable<ItemType>::value, "items are copied to and from pages byte for byte");
+
+
+//orders an item and a key by key, for the searches inside a leaf
+static bool ItemBefore(/*in*/const ItemType& item, /*in*/KeyType key)
+{
+	return item.key < key;
+
+}//end ItemBefore
+
+
+/*****************************************************************************************************/
+
+//Pre: cachePages > 0, pool is nullptr or outlives the list
+//Post: a new empty list has been created over the scratch file fileName (created or emptied). at most
+//		cachePages pages (4 KB each, at least PageCacheClass::MIN_CAPACITY) are held in memory, and leaves
+//		are read ahead on pool (nullptr for the default pool)
+//Exceptions thrown: throws a FileException if fileName can not be created
+//					 throws an OutOfMemoryException if the freestore is out of memory
+DiskListClass::DiskListClass(	/*in*/string fileName,				//scratch file for the pages
+								/*in*/int cachePages,				//pages held in memory
+								/*in*/ThreadPoolClass* pool)		//pool the read ahead runs on
+	: cache(fileName, cachePages, pool)
+{
+	root = NO_PAGE;
+	firstLeaf = NO_PAGE;
+	height = 0;
+	length = 0;
+	currLeaf = NO_PAGE;
+	currSlot = 0;
+	atEnd = false;
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: the cache has been released and the scratch file removed
+DiskListClass::~DiskListClass()
+{
+	//the cache removes the scratch file, nothing in it outlives the list
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns true to the caller if the list is empty, false otherwise
+bool DiskListClass::IsEmpty() const
+{
+	return (length == 0);
+
+}//end IsEmpty
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns true to the caller if the list is full, false otherwise
+bool DiskListClass::IsFull() const
+{
+	return false;
+
+}//end IsFull
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns true to the caller if at the end of the list. as in OrdListClass this is the case on the
+//		last position, and once NextPosition has been called there
+bool DiskListClass::EndOfList()
+{
+	return (length == 0 || atEnd);
+
+}//end EndOfList
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: sets the current position of the list to the first (smallest) element in the list
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::FirstPosition()
+{
+	atEnd = false;
+	if (length == 0)
+	{
+		currLeaf = NO_PAGE;
+		return;
+
+	}//end if
+
+	EnterLeaf(firstLeaf);
+
+}//end FirstPosition
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: sets the current position of the list to the next greatest element in the list. on entering a leaf
+//		the one after it is read ahead, so a scan finds every leaf but the first already in memory
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::NextPosition()
+{
+	if (EndOfList())
+	{
+		return;
+
+	}//end if
+
+	LeafPage* leaf = (LeafPage*)cache.Pin(currLeaf);
+	int count = leaf->header.count;
+	PageId next = leaf->header.next;
+
+	cache.Unpin(currLeaf, false);
+
+	if (currSlot + 1 < count)
+	{
+		++currSlot;
+
+	}//end if
+
+	else
+	{
+		EnterLeaf(next);
+
+	}//end else
+
+	//no item after this one: stay on the last item, as OrdListClass does
+
+	if (atEnd)
+	{
+		LastPosition();
+
+	}//end if
+
+}//end NextPosition
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: sets the current position of the list to the last (greatest) element in the list
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::LastPosition()
+{
+	if (length == 0)
+	{
+		currLeaf = NO_PAGE;
+		return;
+
+	}//end if
+
+	currLeaf = rLastLeaf(root, height);
+
+	LeafPage* leaf = (LeafPage*)cache.Pin(currLeaf);
+	currSlot = leaf->header.count - 1;
+	cache.Unpin(currLeaf, false);
+
+	//as in OrdListClass, the last position is also the end of the list
+	atEnd = true;
+
+}//end LastPosition
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, key is a valid KeyType
+//Post: returns true to the caller if the key was found, false otherwise. the current position is set to
+//		the found item or where it would appear in the list. reads one page per level
+//Exceptions thrown: throws a FileException if a page can not be read
+bool DiskListClass::Find(/*in*/KeyType key) //key to find
+{
+	PageId page = root;
+	bool found;
+
+	atEnd = false;
+	if (root == NO_PAGE)
+	{
+		currLeaf = NO_PAGE;
+		return false;
+
+	}//end if
+
+	for (int level = height; level > 1; --level)
+	{
+		InnerPage* inner = (InnerPage*)cache.Pin(page);
+		PageId child = inner->children[upper_bound(inner->keys, inner->keys + inner->header.count, key) - inner->keys];
+
+		cache.Unpin(page, false);
+		page = child;
+
+	}//end for
+
+	LeafPage* leaf = (LeafPage*)cache.Pin(page);
+
+	currSlot = (int)(lower_bound(leaf->items, leaf->items + leaf->header.count, key, ItemBefore) - leaf->items);
+	found = (currSlot < leaf->header.count && leaf->items[currSlot].key == key);
+	cache.Unpin(page, false);
+
+	currLeaf = page;
+	return found;
+
+}//end Find
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns the item at the current position to the caller
+//Exceptions thrown: throws a RetrieveOnEmptyException if the caller attempts to Retrieve an item on an
+//					 empty list
+//					 throws a FileException if a page can not be read
+ItemType DiskListClass::Retrieve() const
+{
+	ItemType temp;
+
+	if (length == 0 || currLeaf == NO_PAGE)
+	{
+		throw RetrieveOnEmptyException();
+
+	}//end if
+
+	LeafPage* leaf = (LeafPage*)cache.Pin(currLeaf);
+	temp = leaf->items[currSlot];
+	cache.Unpin(currLeaf, false);
+
+	return temp;
+
+}//end Retrieve
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: newItem is inserted into the correct position in the list and the current position left on it. a
+//		full page is split in two, and so on up the path. the leaf at the end of the list is split without
+//		moving anything, so keys inserted in increasing order fill their pages
+//Exceptions thrown: throws a DuplicateKeyException if the caller attempts to insert a item that
+//					 is already in the list
+//					 throws a FileException if a page can not be read or written back
+//					 the list is not changed when an exception is thrown
+bool DiskListClass::Insert(/*in*/ItemType newItem) //item to insert into the list
+{
+	vector<PageId> path;		//pages from the root down to the leaf, all pinned
+	vector<char*> pages;		//bytes of every page of path
+	vector<int> slots;			//child taken in every inner page of path
+	vector<PageId> fresh;		//pages allocated for the splits, all pinned
+	vector<char*> freshPages;	//bytes of every page of fresh
+	int slot;
+	int splits = 0;
+
+	try
+	{
+		path.reserve(height + 1);
+		pages.reserve(height + 1);
+		slots.reserve(height + 1);
+		fresh.reserve(height + 2);
+		freshPages.reserve(height + 2);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	//First element in the list: one leaf is the whole tree
+	if (root == NO_PAGE)
+	{
+		char* bytes;
+		PageId page = cache.Allocate(bytes);
+		LeafPage* leaf = (LeafPage*)bytes;
+
+		leaf->header.leaf = 1;
+		leaf->header.count = 1;
+		leaf->header.next = NO_PAGE;
+		leaf->items[0] = newItem;
+		cache.Unpin(page, true);
+
+		root = page;
+		firstLeaf = page;
+		height = 1;
+		length = 1;
+		currLeaf = page;
+		currSlot = 0;
+		atEnd = false;
+		return true;
+
+	}//end if
+
+	//pin the whole path, and allocate every page the splits need, before anything changes: a read or write
+	//back that fails then leaves the tree as it was
+
+	try
+	{
+		PageId page = root;
+
+		for (int level = height; level > 1; --level)
+		{
+			InnerPage* inner = (InnerPage*)cache.Pin(page);
+
+			path.push_back(page);
+			pages.push_back((char*)inner);
+			slots.push_back((int)(upper_bound(inner->keys, inner->keys + inner->header.count, newItem.key) - inner->keys));
+			page = inner->children[slots.back()];
+
+		}//end for
+
+		LeafPage* leaf = (LeafPage*)cache.Pin(page);
+
+		path.push_back(page);
+		pages.push_back((char*)leaf);
+		slot = (int)(lower_bound(leaf->items, leaf->items + leaf->header.count, newItem.key, ItemBefore) - leaf->items);
+
+		if (slot < leaf->header.count && leaf->items[slot].key == newItem.key)
+		{
+			throw DuplicateKeyException();
+
+		}//end if
+
+		//a full leaf splits, and so does every full inner page right above a page that splits
+
+		if (leaf->header.count == LEAF_CAPACITY)
+		{
+			splits = 1;
+			while (splits < (int)path.size() && ((InnerPage*)pages[path.size() - 1 - splits])->header.count == INNER_CAPACITY)
+			{
+				++splits;
+
+			}//end while
+
+		}//end if
+
+		//one page per split, and a new root if the old one splits
+		for (int i = 0; i < splits + ((splits == (int)path.size()) ? 1 : 0); ++i)
+		{
+			char* bytes;
+
+			fresh.push_back(cache.Allocate(bytes));
+			freshPages.push_back(bytes);
+
+		}//end for
+
+	}//end try
+
+	catch (...)
+	{
+		//pages allocated here are linked to nothing: give them back for the next Insert
+
+		UnpinAll(path, false);
+		UnpinAll(fresh, true);
+		for (size_t i = 0; i < fresh.size(); ++i)
+		{
+			cache.Release(fresh[i]);
+
+		}//end for
+
+		throw;
+
+	}//end catch
+
+	//from here on nothing can fail
+
+	LeafPage* leaf = (LeafPage*)pages.back();
+	bool append = (slot == LEAF_CAPACITY && leaf->header.next == NO_PAGE);
+	KeyType separator = KeyType();
+	PageId right = NO_PAGE;
+	LeafPage* target = leaf;
+
+	currLeaf = path.back();
+	if (splits > 0)
+	{
+		//at the end of the list nothing moves, the new leaf starts out with just the new item
+
+		LeafPage* sibling = (LeafPage*)freshPages[0];
+		int keep = append ? LEAF_CAPACITY : LEAF_CAPACITY / 2;
+
+		sibling->header.leaf = 1;
+		sibling->header.count = LEAF_CAPACITY - keep;
+		sibling->header.next = leaf->header.next;
+		memcpy(sibling->items, leaf->items + keep, (LEAF_CAPACITY - keep) * sizeof(ItemType));
+		leaf->header.count = keep;
+		leaf->header.next = fresh[0];
+
+		if (slot > keep || append)
+		{
+			target = sibling;
+			currLeaf = fresh[0];
+			slot -= keep;
+
+		}//end if
+
+		right = fresh[0];
+
+	}//end if
+
+	memmove(target->items + slot + 1, target->items + slot, (target->header.count - slot) * sizeof(ItemType));
+	target->items[slot] = newItem;
+	++target->header.count;
+	currSlot = slot;
+
+	if (splits > 0)
+	{
+		separator = ((LeafPage*)freshPages[0])->items[0].key;
+
+	}//end if
+
+	//hand the separator of every split up to the page above it
+
+	for (int level = 1; level <= splits && level < (int)path.size(); ++level)
+	{
+		size_t i = path.size() - 1 - level;
+		InnerPage* inner = (InnerPage*)pages[i];
+		int at = slots[i];
+
+		if (level < splits)
+		{
+			//full: lay out the keys and children as if the separator fit, then cut around the middle (or,
+			//at the end of the list, just past the old keys)
+
+			KeyType keys[INNER_CAPACITY + 1];
+			PageId children[INNER_CAPACITY + 2];
+			InnerPage* sibling = (InnerPage*)freshPages[level];
+			int mid = append ? INNER_CAPACITY : (INNER_CAPACITY + 1) / 2;
+
+			copy(inner->keys, inner->keys + at, keys);
+			keys[at] = separator;
+			copy(inner->keys + at, inner->keys + INNER_CAPACITY, keys + at + 1);
+			copy(inner->children, inner->children + at + 1, children);
+			children[at + 1] = right;
+			copy(inner->children + at + 1, inner->children + INNER_CAPACITY + 1, children + at + 2);
+
+			inner->header.count = mid;
+			copy(keys, keys + mid, inner->keys);
+			copy(children, children + mid + 1, inner->children);
+
+			sibling->header.leaf = 0;
+			sibling->header.count = INNER_CAPACITY - mid;
+			sibling->header.next = NO_PAGE;
+			copy(keys + mid + 1, keys + INNER_CAPACITY + 1, sibling->keys);
+			copy(children + mid + 1, children + INNER_CAPACITY + 2, sibling->children);
+
+			separator = keys[mid];
+			right = fresh[level];
+
+		}//end if
+
+		else
+		{
+			int count = inner->header.count;
+
+			memmove(inner->keys + at + 1, inner->keys + at, (count - at) * sizeof(KeyType));
+			memmove(inner->children + at + 2, inner->children + at + 1, (count - at) * sizeof(PageId));
+			inner->keys[at] = separator;
+			inner->children[at + 1] = right;
+			++inner->header.count;
+
+		}//end else
+
+	}//end for
+
+	//the root split: a new root above the two halves
+	if (splits == (int)path.size())
+	{
+		InnerPage* top = (InnerPage*)freshPages[splits];
+
+		top->header.leaf = 0;
+		top->header.count = 1;
+		top->header.next = NO_PAGE;
+		top->keys[0] = separator;
+		top->children[0] = root;
+		top->children[1] = right;
+		root = fresh[splits];
+		++height;
+
+	}//end if
+
+	//the leaf and every page up to the highest split (which took a separator) were changed
+	for (size_t i = 0; i < path.size(); ++i)
+	{
+		cache.Unpin(path[i], (int)(path.size() - 1 - i) <= splits);
+
+	}//end for
+
+	UnpinAll(fresh, true);
+	++length;
+	atEnd = false;
+	return true;
+
+}//end Insert
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, Find has been called to set the current position to the
+//		element that needs to be deleted
+//Post: the element at the current position has been removed from the list, and the current position is
+//		on the element after it (the last one if there is none). a leaf left empty is unlinked from the tree
+//		and the chain and its page reused by the next Insert that needs one
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::Delete()
+{
+	LeafPage* leaf = (LeafPage*)cache.Pin(currLeaf);
+	int count = leaf->header.count - 1;
+	PageId next = leaf->header.next;
+	KeyType key = leaf->items[currSlot].key;
+
+	memmove(leaf->items + currSlot, leaf->items + currSlot + 1, (count - currSlot) * sizeof(ItemType));
+	leaf->header.count = count;
+	cache.Unpin(currLeaf, true);
+	--length;
+
+	//the last item gone: start over with an empty file
+	if (length == 0)
+	{
+		Clear();
+		return;
+
+	}//end if
+
+	if (count == 0)
+	{
+		try
+		{
+			RemoveLeaf(key);
+
+		}//end try
+
+		catch (...)
+		{
+			//the item is gone either way. the empty leaf stays in the chain, where EnterLeaf and rLastLeaf
+			//step over it
+
+		}//end catch
+
+	}//end if
+
+	if (currSlot >= count)
+	{
+		EnterLeaf(next);
+		if (atEnd)
+		{
+			LastPosition();
+
+		}//end if
+
+	}//end if
+
+}//end Delete
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: all elements have been removed from the list and the scratch file emptied
+//Exceptions thrown: throws a FileException if the file can not be emptied
+void DiskListClass::Clear()
+{
+	root = NO_PAGE;
+	firstLeaf = NO_PAGE;
+	height = 0;
+	length = 0;
+	currLeaf = NO_PAGE;
+	currSlot = 0;
+	atEnd = false;
+	cache.Clear();
+
+}//end Clear
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns the length of the current list to the caller
+int DiskListClass::ReturnLength() const
+{
+	return length;
+
+}//end ReturnLength
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, visit is a valid FunctionType. Client needs to match datatype
+//Post: the current list has been printed to the console in order, formatted by the client
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::PrintScreen(/*inout*/FunctionType visit) //function pointer. passes control back to client
+{
+	PageId page = firstLeaf;
+
+	while (page != NO_PAGE)
+	{
+		LeafPage* leaf = (LeafPage*)cache.Pin(page);
+		PageId next = leaf->header.next;
+
+		try
+		{
+			cache.Prefetch(next);
+			for (int i = 0; i < leaf->header.count; ++i)
+			{
+				visit(leaf->items[i]);
+
+			}//end for
+
+		}//end try
+
+		catch (...)
+		{
+			cache.Unpin(page, false);
+			throw;
+
+		}//end catch
+
+		cache.Unpin(page, false);
+		page = next;
+
+	}//end while
+
+}//end PrintScreen
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, visit is a valid FunctionTypeFile. Client needs to match datatype
+//Post: the current list has been printed in order to a file specified and formatted by the client
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::PrintFile(	/*inout*/FunctionTypeFile visit,	//function pointer that passes control back to client
+								/*inout*/string fileName)			//filename to write the data to
+{
+	ofstream outdat(fileName);
+	PageId page = firstLeaf;
+
+	while (page != NO_PAGE)
+	{
+		LeafPage* leaf = (LeafPage*)cache.Pin(page);
+		PageId next = leaf->header.next;
+
+		try
+		{
+			cache.Prefetch(next);
+			for (int i = 0; i < leaf->header.count; ++i)
+			{
+				visit(leaf->items[i], outdat);
+
+			}//end for
+
+		}//end try
+
+		catch (...)
+		{
+			cache.Unpin(page, false);
+			throw;
+
+		}//end catch
+
+		cache.Unpin(page, false);
+		page = next;
+
+	}//end while
+
+}//end PrintFile
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns the number of levels of pages to the caller, 0 for an empty list. a Find reads this many
+int DiskListClass::ReturnHeight() const
+{
+	return height;
+
+}//end ReturnHeight
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: returns the hit, miss, prefetch, eviction and write back counters of the page cache to the caller
+CacheStats DiskListClass::Stats() const
+{
+	return cache.Stats();
+
+}//end Stats
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated
+//Post: every counter of the page cache has been set back to zero
+void DiskListClass::ResetStats()
+{
+	cache.ResetStats();
+
+}//end ResetStats
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, page is a leaf or NO_PAGE
+//Post: the current position is on the first item of the first leaf of the chain from page on that is not
+//		empty, and the leaf after it is being read ahead. EndOfList is true if every leaf is empty
+//Exceptions thrown: throws a FileException if a page can not be read
+void DiskListClass::EnterLeaf(/*in*/PageId page) //first leaf to look at
+{
+	while (page != NO_PAGE)
+	{
+		LeafPage* leaf = (LeafPage*)cache.Pin(page);
+		int count = leaf->header.count;
+		PageId next = leaf->header.next;
+
+		cache.Unpin(page, false);
+
+		if (count > 0)
+		{
+			currLeaf = page;
+			currSlot = 0;
+			cache.Prefetch(next);
+			return;
+
+		}//end if
+
+		page = next;
+
+	}//end while
+
+	atEnd = true;
+
+}//end EnterLeaf
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, the leaf key leads to has just been emptied and is not the root
+//Post: the leaf has been unlinked from its parent and from the chain and its page released. an inner page
+//		left without a child goes the same way, and a root left with one child is replaced by it
+//Exceptions thrown: throws a FileException if a page can not be read
+//					 the list is not changed when an exception is thrown
+void DiskListClass::RemoveLeaf(/*in*/KeyType key) //key that was in the leaf
+{
+	vector<PageId> path;		//pages from the root down to the leaf, all pinned
+	vector<char*> pages;		//bytes of every page of path
+	vector<int> slots;			//child taken in every inner page of path
+	PageId before = NO_PAGE;	//leaf ahead of it in the chain, pinned. NO_PAGE if it is the first
+	LeafPage* prior = NULL;		//bytes of before
+	int top;					//inner page of path that keeps its other children
+	int drop = 0;				//pages at the top of path given up because they are left with one child
+
+	try
+	{
+		path.reserve(height);
+		pages.reserve(height);
+		slots.reserve(height);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	//pin the path, and the leaf ahead, before anything changes
+
+	try
+	{
+		PageId page = root;
+
+		for (int level = height; level > 1; --level)
+		{
+			InnerPage* inner = (InnerPage*)cache.Pin(page);
+
+			path.push_back(page);
+			pages.push_back((char*)inner);
+			slots.push_back((int)(upper_bound(inner->keys, inner->keys + inner->header.count, key) - inner->keys));
+			page = inner->children[slots.back()];
+
+		}//end for
+
+		path.push_back(page);
+		pages.push_back(cache.Pin(page));
+
+		//the leaf ahead is the last one of the child left of the path, at the lowest page where the path did
+		//not take the first child
+
+		int turn = (int)slots.size() - 1;
+
+		while (turn >= 0 && slots[turn] == 0)
+		{
+			--turn;
+
+		}//end while
+
+		if (turn >= 0)
+		{
+			page = ((InnerPage*)pages[turn])->children[slots[turn] - 1];
+			for (int level = height - turn - 1; level > 1; --level)
+			{
+				InnerPage* inner = (InnerPage*)cache.Pin(page);
+				PageId child = inner->children[inner->header.count];
+
+				cache.Unpin(page, false);
+				page = child;
+
+			}//end for
+
+			prior = (LeafPage*)cache.Pin(page);
+			before = page;
+
+		}//end if
+
+	}//end try
+
+	catch (...)
+	{
+		UnpinAll(path, false);
+		throw;
+
+	}//end catch
+
+	//from here on nothing can fail
+
+	LeafPage* leaf = (LeafPage*)pages.back();
+
+	if (before == NO_PAGE)
+	{
+		firstLeaf = leaf->header.next;
+
+	}//end if
+
+	else
+	{
+		prior->header.next = leaf->header.next;
+		cache.Unpin(before, true);
+
+	}//end else
+
+	//the leaf leaves its parent, and a parent that had no other child leaves its own, and so on up
+
+	top = (int)path.size() - 2;
+	while (top > 0 && ((InnerPage*)pages[top])->header.count == 0)
+	{
+		--top;
+
+	}//end while
+
+	InnerPage* parent = (InnerPage*)pages[top];
+	int child = slots[top];
+	int gone = (child > 0) ? child - 1 : 0;		//key that no longer separates two children
+
+	memmove(parent->keys + gone, parent->keys + gone + 1, (parent->header.count - gone - 1) * sizeof(KeyType));
+	memmove(parent->children + child, parent->children + child + 1, (parent->header.count - child) * sizeof(PageId));
+	--parent->header.count;
+
+	//a root with one child, and every page under it with one child, no longer split anything
+	while (drop <= top && ((InnerPage*)pages[drop])->header.count == 0)
+	{
+		++drop;
+
+	}//end while
+
+	if (drop > 0)
+	{
+		root = ((InnerPage*)pages[drop - 1])->children[0];
+		height -= drop;
+
+	}//end if
+
+	for (int i = 0; i < (int)path.size(); ++i)
+	{
+		cache.Unpin(path[i], i == top);
+
+	}//end for
+
+	for (int i = 0; i < (int)path.size(); ++i)
+	{
+		if (i < drop || i > top)
+		{
+			cache.Release(path[i]);
+
+		}//end if
+
+	}//end for
+
+}//end RemoveLeaf
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, page is on level level (leaves are on level 1)
+//Post: returns the last leaf below page that is not empty to the caller, NO_PAGE if they all are
+//Exceptions thrown: throws a FileException if a page can not be read
+PageId DiskListClass::rLastLeaf(/*in*/PageId page,			//root of the subtree
+								/*in*/int level) const		//its level
+{
+	if (level == 1)
+	{
+		LeafPage* leaf = (LeafPage*)cache.Pin(page);
+		int count = leaf->header.count;
+
+		cache.Unpin(page, false);
+		return (count > 0) ? page : NO_PAGE;
+
+	}//end if
+
+	//right to left, so only an empty leaf a Delete could not unlink is ever stepped over
+
+	vector<PageId> children;
+	InnerPage* inner = (InnerPage*)cache.Pin(page);
+
+	try
+	{
+		children.assign(inner->children, inner->children + inner->header.count + 1);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		cache.Unpin(page, false);
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	cache.Unpin(page, false);
+
+	for (size_t i = children.size(); i > 0; --i)
+	{
+		PageId found = rLastLeaf(children[i - 1], level - 1);
+
+		if (found != NO_PAGE)
+		{
+			return found;
+
+		}//end if
+
+	}//end for
+
+	return NO_PAGE;
+
+}//end rLastLeaf
+
+
+/*****************************************************************************************************/
+
+//Pre: DiskListClass has been instantiated, every page of pages is pinned
+//Post: every page of pages has been unpinned once, marked dirty if dirty is true
+void DiskListClass::UnpinAll(	/*in*/const vector<PageId>& pages,	//pages to release
+								/*in*/bool dirty) const				//true if they were changed
+{
+	for (size_t i = 0; i < pages.size(); ++i)
+	{
+		cache.Unpin(pages[i], dirty);
+
+	}//end for
+
+}//end UnpinAll
@@ -0,0 +1,323 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: DiskList.h
+Purpose: Provides the specification for an ordered list that keeps its items on disk, for key sets larger
+		than memory. The client uses it like OrdListClass: Find, Insert, Delete and the cursor functions take
+		and return the same things. Behind the scenes the list is a B+ tree of 4 KB pages held by a
+		PageCacheClass: inner pages route a key to one of about 500 children, leaves hold about 1000 items
+		and are chained in key order. A Find reads one page per level, log_B(N) pages with B in the hundreds,
+		and the upper levels are used so often that the cache keeps them, so a lookup usually costs one read.
+		NextPosition walks the leaf chain and reads the next leaf ahead on the thread pool.
+Input: All input is done via client
+Output: Supports a function pointer containing a output file stream. Client handles formatting of all print
+		functions. The pages live in a scratch file that is removed with the list.
+Assumptions: ItemType can be copied byte for byte to and from a page. One thread uses the list.
+*/
+
+#ifndef DISK_LIST
+#define DISK_LIST
+
+#include <fstream>
+#include <string>
+#include "ItemType.h"
+#include "PageCache.h"
+
+using namespace std;
+
+//the visit functions of OrdListClass
+typedef void(*FunctionType)(const ItemType&);
+
+typedef void(*FunctionTypeFile)(const ItemType&, ofstream&);
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+DiskListClass(string fileName, int cachePages, ThreadPoolClass* pool);
+	a new empty list has been created over the scratch file fileName, with cachePages pages in memory
+
+~DiskListClass();
+	the cache has been released and the scratch file removed
+
+bool IsEmpty() const;
+	returns true to the caller if the list is empty, false otherwise
+
+bool IsFull() const;
+	returns true to the caller if the list is full, false otherwise
+
+bool EndOfList();
+	returns true to the caller if at the end of the list, as OrdListClass does
+
+void FirstPosition();
+	sets the current position of the list to the first (smallest) element in the list
+
+void NextPosition();
+	sets the current position of the list to the next greatest element in the list
+
+void LastPosition();
+	sets the current position of the list to the last (greatest) element in the list
+
+bool Find(KeyType key);
+	returns true to the caller if the key was found, false otherwise. the current position is set to the
+	found item or where it would appear in the list
+
+ItemType Retrieve() const;
+	returns the item at the current position to the caller
+
+bool Insert(ItemType newItem);
+	newItem is inserted into the correct position in the list
+
+void Delete();
+	the element at the current position has been removed from the list
+
+void Clear();
+	all elements have been removed from the list and the scratch file emptied
+
+int ReturnLength() const;
+	returns the length of the current list to the caller
+
+void PrintScreen(FunctionType visit);
+	the current list has been printed to the console in order, formatted by the client
+
+void PrintFile(FunctionTypeFile visit, string fileName);
+	the current list has been printed in order to a file specified and formatted by the client
+
+int ReturnHeight() const;
+	returns the number of levels of pages to the caller
+
+CacheStats Stats() const;
+	returns the hit, miss, prefetch, eviction and write back counters of the page cache to the caller
+
+void ResetStats();
+	every counter of the page cache has been set back to zero
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void EnterLeaf(PageId page);
+	the current position is on the first item of the first leaf from page on that is not empty
+
+void RemoveLeaf(KeyType key);
+	the emptied leaf key leads to has been unlinked from the tree and the chain and its page released
+
+PageId rLastLeaf(PageId page, int level) const;
+	returns the last leaf below page that is not empty to the caller
+
+void UnpinAll(const vector<PageId>& pages, bool dirty) const;
+	every page of pages has been unpinned once
+*/
+
+class DiskListClass
+{
+
+public:
+
+	/*****************************************************************************************************/
+
+	//Pre: cachePages > 0, pool is nullptr or outlives the list
+	//Post: a new empty list has been created over the scratch file fileName (created or emptied). at most
+	//		cachePages pages (4 KB each, at least PageCacheClass::MIN_CAPACITY) are held in memory, and leaves
+	//		are read ahead on pool (nullptr for the default pool)
+	//Exceptions thrown: throws a FileException if fileName can not be created
+	//					 throws an OutOfMemoryException if the freestore is out of memory
+	DiskListClass(	/*in*/string fileName,				//scratch file for the pages
+					/*in*/int cachePages,				//pages held in memory
+					/*in*/ThreadPoolClass* pool);		//pool the read ahead runs on
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: the cache has been released and the scratch file removed
+	~DiskListClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns true to the caller if the list is empty, false otherwise
+	bool IsEmpty() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns true to the caller if the list is full, false otherwise
+	bool IsFull() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns true to the caller if at the end of the list. as in OrdListClass this is the case on the
+	//		last position, and once NextPosition has been called there
+	bool EndOfList();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: sets the current position of the list to the first (smallest) element in the list
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void FirstPosition();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: sets the current position of the list to the next greatest element in the list. on entering a leaf
+	//		the one after it is read ahead, so a scan finds every leaf but the first already in memory
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void NextPosition();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: sets the current position of the list to the last (greatest) element in the list
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void LastPosition();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, key is a valid KeyType
+	//Post: returns true to the caller if the key was found, false otherwise. the current position is set to
+	//		the found item or where it would appear in the list. reads one page per level
+	//Exceptions thrown: throws a FileException if a page can not be read
+	bool Find(/*in*/KeyType key); //key to find
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns the item at the current position to the caller
+	//Exceptions thrown: throws a RetrieveOnEmptyException if the caller attempts to Retrieve an item on an
+	//					 empty list
+	//					 throws a FileException if a page can not be read
+	ItemType Retrieve() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: newItem is inserted into the correct position in the list and the current position left on it. a
+	//		full page is split in two, and so on up the path. the leaf at the end of the list is split without
+	//		moving anything, so keys inserted in increasing order fill their pages
+	//Exceptions thrown: throws a DuplicateKeyException if the caller attempts to insert a item that
+	//					 is already in the list
+	//					 throws a FileException if a page can not be read or written back
+	//					 the list is not changed when an exception is thrown
+	bool Insert(/*in*/ItemType newItem); //item to insert into the list
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, Find has been called to set the current position to the
+	//		element that needs to be deleted
+	//Post: the element at the current position has been removed from the list, and the current position is
+	//		on the element after it (the last one if there is none). a leaf left empty is unlinked from the tree
+	//		and the chain and its page reused by the next Insert that needs one
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void Delete();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: all elements have been removed from the list and the scratch file emptied
+	//Exceptions thrown: throws a FileException if the file can not be emptied
+	void Clear();
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns the length of the current list to the caller
+	int ReturnLength() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, visit is a valid FunctionType. Client needs to match datatype
+	//Post: the current list has been printed to the console in order, formatted by the client
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void PrintScreen(/*inout*/FunctionType visit); //function pointer. passes control back to client
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, visit is a valid FunctionTypeFile. Client needs to match datatype
+	//Post: the current list has been printed in order to a file specified and formatted by the client
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void PrintFile(	/*inout*/FunctionTypeFile visit,	//function pointer that passes control back to client
+					/*inout*/string fileName);			//filename to write the data to
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns the number of levels of pages to the caller, 0 for an empty list. a Find reads this many
+	int ReturnHeight() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: returns the hit, miss, prefetch, eviction and write back counters of the page cache to the caller
+	CacheStats Stats() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated
+	//Post: every counter of the page cache has been set back to zero
+	void ResetStats();
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, page is a leaf or NO_PAGE
+	//Post: the current position is on the first item of the first leaf of the chain from page on that is not
+	//		empty, and the leaf after it is being read ahead. EndOfList is true if every leaf is empty
+	//Exceptions thrown: throws a FileException if a page can not be read
+	void EnterLeaf(/*in*/PageId page); //first leaf to look at
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, the leaf key leads to has just been emptied and is not the root
+	//Post: the leaf has been unlinked from its parent and from the chain and its page released. an inner page
+	//		left without a child goes the same way, and a root left with one child is replaced by it
+	//Exceptions thrown: throws a FileException if a page can not be read
+	//					 the list is not changed when an exception is thrown
+	void RemoveLeaf(/*in*/KeyType key); //key that was in the leaf
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, page is on level level (leaves are on level 1)
+	//Post: returns the last leaf below page that is not empty to the caller, NO_PAGE if they all are
+	//Exceptions thrown: throws a FileException if a page can not be read
+	PageId rLastLeaf(	/*in*/PageId page,			//root of the subtree
+						/*in*/int level) const;		//its level
+
+	/*****************************************************************************************************/
+
+	//Pre: DiskListClass has been instantiated, every page of pages is pinned
+	//Post: every page of pages has been unpinned once, marked dirty if dirty is true
+	void UnpinAll(	/*in*/const vector<PageId>& pages,	//pages to release
+					/*in*/bool dirty) const;			//true if they were changed
+
+	/*****************************************************************************************************/
+
+private:
+
+	mutable PageCacheClass cache;	//the pages. reading them is not a change to the list
+	PageId root;					//root page, NO_PAGE for an empty list
+	PageId firstLeaf;				//leftmost leaf, the head of the chain
+	int height;						//levels of pages, leaves included
+	int length;						//items in the list
+	PageId currLeaf;				//leaf of the current position
+	int currSlot;					//item of currLeaf at the current position
+	bool atEnd;						//true once the current position is the end of the list
+
+	//no copies, the pages belong to one scratch file
+	DiskListClass(const DiskListClass&);
+	void operator=(const DiskListClass&);
+
+};
+
+#endif
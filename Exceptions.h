@@ -13,4 +13,10 @@ class RetrieveOnEmptyException{};
 class DuplicateKeyException{};
 
 //thrown when the freestore is out of memory
-class OutOfMemoryException{};
\ No newline at end of file
+class OutOfMemoryException{};
+
+//thrown when client attempts to join two lists whose key ranges overlap
+class KeyRangeOverlapException{};
+
+//thrown when a file can not be opened, read or written, or does not hold what was expected
+class FileException{};
\ No newline at end of file
@@ -0,0 +1,309 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: HashIndex.cpp
+Purpose: Provides the implementation for the hash side index OrdListClass can keep next to its tree.
+Input: All input is done via OrdListClass
+Output: none
+Assumptions: The index owns no node, it only points at the nodes of the tree it is kept for.
+*/
+
+
+#include "HashIndex.h"
+
+using namespace std;
+
+static const int MIN_CAPACITY = 16;			//smallest table allocated
+static const double MIN_LOAD = 0.1;			//load factors are clamped to [MIN_LOAD, MAX_LOAD]
+static const double MAX_LOAD = 0.95;
+
+//2^64 / golden ratio. multiplying by it spreads runs of consecutive keys over the whole table
+static const unsigned long long FIBONACCI_MULTIPLIER = 11400714819323198485ull;
+
+
+/*****************************************************************************************************/
+
+//Pre: 0 < loadFactor < 1. values outside [0.1, 0.95] are clamped
+//Post: a new empty index has been created that grows once it is more than loadFactor full. lower load
+//		factors cost more memory per key and give shorter probes
+HashIndexClass::HashIndexClass(/*in*/double loadFactor) //largest fraction of slots in use
+{
+	slots = nullptr;
+	capacity = 0;
+	shift = 64;
+	count = 0;
+	maxLoad = loadFactor;
+
+	if (!(maxLoad >= MIN_LOAD))
+	{
+		maxLoad = MIN_LOAD;
+
+	}//end if
+
+	if (maxLoad > MAX_LOAD)
+	{
+		maxLoad = MAX_LOAD;
+
+	}//end if
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: the slots have been returned to the freestore
+HashIndexClass::~HashIndexClass()
+{
+	delete[] slots;
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: returns the node stored for key to the caller, nullptr if there is none
+node* HashIndexClass::Find(/*in*/KeyType key) const //key to look up
+{
+	if (count == 0)
+	{
+		return nullptr;
+
+	}//end if
+
+	int mask = capacity - 1;
+	for (int i = HomeOf(key); slots[i].trav != nullptr; i = (i + 1) & mask)
+	{
+		if (slots[i].key == key)
+		{
+			return slots[i].trav;
+
+		}//end if
+
+	}//end for
+
+	return nullptr;
+
+}//end Find
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated, trav is not nullptr
+//Post: key maps to trav, replacing whatever it mapped to before
+//Exceptions thrown: throws bad_alloc if the table has to grow and the freestore is out of memory
+void HashIndexClass::Insert(/*in*/KeyType key,		//key of trav
+							/*in*/node* trav)		//node that holds key
+{
+	if (count + 1 > maxLoad * capacity)
+	{
+		Resize(capacity < MIN_CAPACITY ? MIN_CAPACITY : capacity * 2);
+
+	}//end if
+
+	int mask = capacity - 1;
+	int i = HomeOf(key);
+
+	while (slots[i].trav != nullptr)
+	{
+		if (slots[i].key == key)
+		{
+			slots[i].trav = trav;
+			return;
+
+		}//end if
+
+		i = (i + 1) & mask;
+
+	}//end while
+
+	slots[i].key = key;
+	slots[i].trav = trav;
+	++count;
+
+}//end Insert
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: key no longer maps to trav. an entry for key that points at another node is left alone, so a
+//		node whose item was just copied elsewhere can be freed without losing the copy's entry
+void HashIndexClass::Erase(	/*in*/KeyType key,		//key to remove
+							/*in*/node* trav)		//node the entry must point at
+{
+	if (count == 0)
+	{
+		return;
+
+	}//end if
+
+	int mask = capacity - 1;
+	int hole = HomeOf(key);
+
+	while (slots[hole].trav != nullptr && slots[hole].key != key)
+	{
+		hole = (hole + 1) & mask;
+
+	}//end while
+
+	if (slots[hole].trav == nullptr || slots[hole].trav != trav)
+	{
+		return;
+
+	}//end if
+
+	//backward shift: pull every later entry of the run whose home is not between the hole and itself back
+	//into the hole, so that no lookup ever has to step over a dead slot
+
+	int next = (hole + 1) & mask;
+	while (slots[next].trav != nullptr)
+	{
+		int home = HomeOf(slots[next].key);
+		bool staysPut = (hole <= next) ? (hole < home && home <= next) : (hole < home || home <= next);
+
+		if (!staysPut)
+		{
+			slots[hole] = slots[next];
+			hole = next;
+
+		}//end if
+
+		next = (next + 1) & mask;
+
+	}//end while
+
+	slots[hole].trav = nullptr;
+	--count;
+
+}//end Erase
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: every entry has been removed. the slots are kept for reuse
+void HashIndexClass::Clear()
+{
+	for (int i = 0; i < capacity; ++i)
+	{
+		slots[i].trav = nullptr;
+
+	}//end for
+
+	count = 0;
+
+}//end Clear
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: count keys fit without the table growing
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+void HashIndexClass::Reserve(/*in*/int count) //number of keys expected
+{
+	int newCapacity = (capacity < MIN_CAPACITY) ? MIN_CAPACITY : capacity;
+
+	while (count > maxLoad * newCapacity)
+	{
+		newCapacity *= 2;
+
+	}//end while
+
+	if (newCapacity != capacity)
+	{
+		Resize(newCapacity);
+
+	}//end if
+
+}//end Reserve
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: returns the number of keys in the index to the caller
+int HashIndexClass::ReturnCount() const
+{
+	return count;
+
+}//end ReturnCount
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: returns the largest fraction of the slots the index fills before it grows
+double HashIndexClass::ReturnLoadFactor() const
+{
+	return maxLoad;
+
+}//end ReturnLoadFactor
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated
+//Post: returns the number of bytes held by the slots to the caller
+long long HashIndexClass::ReturnBytes() const
+{
+	return (long long)capacity * (long long)sizeof(Slot);
+
+}//end ReturnBytes
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated, capacity > 0
+//Post: returns the slot a lookup for key starts at
+int HashIndexClass::HomeOf(/*in*/KeyType key) const //key to hash
+{
+	//Fibonacci hashing: the top bits of the product are the best mixed, so keep those
+
+	return (int)(((unsigned long long)key * FIBONACCI_MULTIPLIER) >> shift);
+
+}//end HomeOf
+
+
+/*****************************************************************************************************/
+
+//Pre: HashIndexClass has been instantiated, newCapacity is a power of two larger than count
+//Post: every entry has been moved to a table of newCapacity slots
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory, the old table is kept
+void HashIndexClass::Resize(/*in*/int newCapacity) //number of slots
+{
+	Slot* oldSlots = slots;
+	int oldCapacity = capacity;
+
+	slots = new Slot[newCapacity];		//throws before anything has changed
+	capacity = newCapacity;
+	count = 0;
+	shift = 64;
+	for (int bits = newCapacity; bits > 1; bits >>= 1)
+	{
+		--shift;
+
+	}//end for
+
+	for (int i = 0; i < capacity; ++i)
+	{
+		slots[i].trav = nullptr;
+
+	}//end for
+
+	for (int i = 0; i < oldCapacity; ++i)
+	{
+		if (oldSlots[i].trav != nullptr)
+		{
+			Insert(oldSlots[i].key, oldSlots[i].trav);
+
+		}//end if
+
+	}//end for
+
+	delete[] oldSlots;
+
+}//end Resize
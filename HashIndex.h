@@ -0,0 +1,188 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: HashIndex.h
+Purpose: Provides the specification for the hash side index OrdListClass can keep next to its tree.
+		The index maps a key straight to the node that holds it, so a point lookup costs one or two probes
+		instead of a descent of the tree. It is an open addressing table with linear probing: slots sit in one
+		array, a lookup walks forward from the key's home slot until it meets the key or an empty slot.
+		Deleting shifts the following entries back instead of leaving tombstones, so lookups never slow down
+		as keys come and go.
+Input: All input is done via OrdListClass
+Output: none
+Assumptions: The index owns no node, it only points at the nodes of the tree it is kept for. A slot costs
+		sizeof(KeyType) + sizeof(node*) bytes (16 on a 64 bit build), so a key costs that over the load factor.
+*/
+
+#ifndef HASH_INDEX
+#define HASH_INDEX
+
+#include "ItemType.h"
+
+using namespace std;
+
+struct node;
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+HashIndexClass(double loadFactor);
+	a new empty index has been created that grows once it is more than loadFactor full
+
+~HashIndexClass();
+	the slots have been returned to the freestore
+
+node* Find(KeyType key) const;
+	returns the node stored for key to the caller, nullptr if there is none
+
+void Insert(KeyType key, node* trav);
+	key maps to trav, replacing whatever it mapped to before
+
+void Erase(KeyType key, node* trav);
+	key no longer maps to trav. an entry for key that points at another node is left alone
+
+void Clear();
+	every entry has been removed
+
+void Reserve(int count);
+	count keys fit without the table growing
+
+int ReturnCount() const;
+	returns the number of keys in the index to the caller
+
+double ReturnLoadFactor() const;
+	returns the largest fraction of the slots the index fills before it grows
+
+long long ReturnBytes() const;
+	returns the number of bytes held by the slots to the caller
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int HomeOf(KeyType key) const;
+	returns the slot a lookup for key starts at
+
+void Resize(int newCapacity);
+	every entry has been moved to a table of newCapacity slots
+*/
+
+class HashIndexClass
+{
+
+public:
+
+	/*****************************************************************************************************/
+
+	//Pre: 0 < loadFactor < 1. values outside [0.1, 0.95] are clamped
+	//Post: a new empty index has been created that grows once it is more than loadFactor full. lower load
+	//		factors cost more memory per key and give shorter probes
+	HashIndexClass(/*in*/double loadFactor); //largest fraction of slots in use
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: the slots have been returned to the freestore
+	~HashIndexClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: returns the node stored for key to the caller, nullptr if there is none
+	node* Find(/*in*/KeyType key) const; //key to look up
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated, trav is not nullptr
+	//Post: key maps to trav, replacing whatever it mapped to before
+	//Exceptions thrown: throws bad_alloc if the table has to grow and the freestore is out of memory
+	void Insert(/*in*/KeyType key,		//key of trav
+				/*in*/node* trav);		//node that holds key
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: key no longer maps to trav. an entry for key that points at another node is left alone, so a
+	//		node whose item was just copied elsewhere can be freed without losing the copy's entry
+	void Erase(	/*in*/KeyType key,		//key to remove
+				/*in*/node* trav);		//node the entry must point at
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: every entry has been removed. the slots are kept for reuse
+	void Clear();
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: count keys fit without the table growing
+	//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+	void Reserve(/*in*/int count); //number of keys expected
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: returns the number of keys in the index to the caller
+	int ReturnCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: returns the largest fraction of the slots the index fills before it grows
+	double ReturnLoadFactor() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated
+	//Post: returns the number of bytes held by the slots to the caller
+	long long ReturnBytes() const;
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated, capacity > 0
+	//Post: returns the slot a lookup for key starts at
+	int HomeOf(/*in*/KeyType key) const; //key to hash
+
+	/*****************************************************************************************************/
+
+	//Pre: HashIndexClass has been instantiated, newCapacity is a power of two larger than count
+	//Post: every entry has been moved to a table of newCapacity slots
+	//Exceptions thrown: throws bad_alloc if the freestore is out of memory, the old table is kept
+	void Resize(/*in*/int newCapacity); //number of slots
+
+	/*****************************************************************************************************/
+
+private:
+
+	struct Slot
+	{
+		KeyType key;
+		node* trav;		//nullptr marks an empty slot
+	};
+
+	Slot* slots;		//the table, capacity entries
+	int capacity;		//number of slots, 0 or a power of two
+	int shift;			//64 - log2(capacity), turns the 64 bit hash into a slot
+	int count;			//slots in use
+	double maxLoad;		//largest count / capacity before the table grows
+
+	//no copies, OrdListClass builds a fresh index for a copied list
+	HashIndexClass(const HashIndexClass&);
+	void operator=(const HashIndexClass&);
+
+};
+
+#endif
@@ -0,0 +1,28 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: KeyHash.h
+Purpose: Provides the key hash shared by the cuckoo filter and the Bloom filters of LsmListClass, so that both
+		spread keys the same way and a change to it is made in one place.
+Input: none
+Output: none
+Assumptions: none
+*/
+
+#ifndef KEY_HASH
+#define KEY_HASH
+
+//Pre: none
+//Post: returns the splitmix64 finalizer of value to the caller. every bit of value is spread over the whole
+//		64 bit hash
+inline unsigned long long Mix(/*in*/unsigned long long value) //value to hash
+{
+	value += 0x9E3779B97F4A7C15ull;
+	value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+	value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+	return value ^ (value >> 31);
+
+}//end Mix
+
+#endif
@@ -0,0 +1,365 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: LatencyHistogram.cpp
+Purpose: Provides the implementation for the latency histograms kept around the public OrdListClass operations.
+Input: All input is done via client
+Output: Percentiles and JSON
+Assumptions: Latencies are in nanoseconds.
+*/
+
+
+#include "LatencyHistogram.h"
+
+#include <climits>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+static const int SUB_BUCKETS = 32;					//buckets per power of two
+static const int MAX_SHIFT = 35;					//values up to 64 << 35 = 2^41 are told apart
+
+static const char* opNames[NUM_LATENCY_OPS] = { "Find", "Insert", "Delete", "NextPosition", "operator+", "PrintFile" };
+
+//every thread gets its own set of histograms the first time it records. the sets are never freed, so the
+//values recorded by a thread that has exited are still part of every snapshot
+struct ThreadHistograms
+{
+	LatencyHistogramClass ops[NUM_LATENCY_OPS];
+};
+
+static mutex registryLock;						//guards registry
+static vector<ThreadHistograms*> registry;		//histograms of every thread that ever recorded
+static thread_local ThreadHistograms* mine = nullptr;
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: a new empty histogram has been created
+LatencyHistogramClass::LatencyHistogramClass()
+{
+	Clear();
+
+}//end default constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: orig is a valid LatencyHistogramClass
+//Post: creates a copy of orig
+LatencyHistogramClass::LatencyHistogramClass(/*in*/const LatencyHistogramClass& orig) //histogram to copy
+{
+	Clear();
+	Merge(orig);
+
+}//end copy constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: LatencyHistogramClass has been instantiated, no other thread records into it
+//Post: nanos has been counted in its bucket. readers on other threads may look at the histogram meanwhile
+void LatencyHistogramClass::Record(/*in*/long long nanos) //latency in nanoseconds
+{
+	int bucket = BucketOf(nanos);
+
+	buckets[bucket].store(buckets[bucket].load(memory_order_relaxed) + 1, memory_order_relaxed);
+	count.store(count.load(memory_order_relaxed) + 1, memory_order_relaxed);
+	sum.store(sum.load(memory_order_relaxed) + nanos, memory_order_relaxed);
+
+	if (nanos < minimum.load(memory_order_relaxed))
+	{
+		minimum.store(nanos, memory_order_relaxed);
+
+	}//end if
+
+	if (nanos > maximum.load(memory_order_relaxed))
+	{
+		maximum.store(nanos, memory_order_relaxed);
+
+	}//end if
+
+}//end Record
+
+
+/*****************************************************************************************************/
+
+//Pre: LatencyHistogramClass has been instantiated
+//Post: every value recorded in other has been added to the current histogram
+void LatencyHistogramClass::Merge(/*in*/const LatencyHistogramClass& other) //histogram to add
+{
+	for (int i = 0; i < NUM_BUCKETS; ++i)
+	{
+		buckets[i] += other.buckets[i].load(memory_order_relaxed);
+
+	}//end for
+
+	count += other.count.load(memory_order_relaxed);
+	sum += other.sum.load(memory_order_relaxed);
+
+	if (other.minimum.load() < minimum.load())
+	{
+		minimum = other.minimum.load();
+
+	}//end if
+
+	if (other.maximum.load() > maximum.load())
+	{
+		maximum = other.maximum.load();
+
+	}//end if
+
+}//end Merge
+
+
+/*****************************************************************************************************/
+
+//Pre: LatencyHistogramClass has been instantiated
+//Post: every bucket has been set back to zero
+void LatencyHistogramClass::Clear()
+{
+	for (int i = 0; i < NUM_BUCKETS; ++i)
+	{
+		buckets[i] = 0;
+
+	}//end for
+
+	count = 0;
+	sum = 0;
+	minimum = LLONG_MAX;
+	maximum = 0;
+
+}//end Clear
+
+
+/*****************************************************************************************************/
+
+//Pre: LatencyHistogramClass has been instantiated
+//Post: returns the number of values recorded to the caller
+long long LatencyHistogramClass::ReturnCount() const
+{
+	return count.load();
+
+}//end ReturnCount
+
+
+/*****************************************************************************************************/
+
+//Pre: LatencyHistogramClass has been instantiated, 0 <= percent <= 100
+//Post: returns the smallest bucket value that at least percent % of the recorded values are at or below.
+//		0 if the histogram is empty
+long long LatencyHistogramClass::Percentile(/*in*/double percent) const //e.g. 99.9 for p999
+{
+	long long total = count.load();
+	long long seen = 0;
+
+	if (total == 0)
+	{
+		return 0;
+
+	}//end if
+
+	//rank of the wanted value, rounded up, at least the first value
+	long long wanted = (long long)(percent / 100.0 * (double)total + 0.999999);
+	if (wanted < 1)
+	{
+		wanted = 1;
+
+	}//end if
+
+	for (int i = 0; i < NUM_BUCKETS; ++i)
+	{
+		seen += buckets[i].load(memory_order_relaxed);
+		if (seen >= wanted)
+		{
+			long long value = BucketValue(i);
+			return (value > maximum.load()) ? maximum.load() : value;
+
+		}//end if
+
+	}//end for
+
+	return maximum.load();
+
+}//end Percentile
+
+
+/*****************************************************************************************************/
+
+//Pre: LatencyHistogramClass has been instantiated
+//Post: returns the count, min, max, mean, p50, p90, p99, p999 and every non empty bucket (as
+//		[largest value, count] pairs, so exported histograms can be merged again) as a JSON object
+string LatencyHistogramClass::ToJson() const
+{
+	stringstream out;
+	long long total = count.load();
+	bool first = true;
+
+	out << "{\"count\": " << total
+		<< ", \"min\": " << (total > 0 ? minimum.load() : 0)
+		<< ", \"max\": " << maximum.load()
+		<< ", \"mean\": " << (total > 0 ? (double)sum.load() / (double)total : 0.0)
+		<< ", \"p50\": " << Percentile(50.0)
+		<< ", \"p90\": " << Percentile(90.0)
+		<< ", \"p99\": " << Percentile(99.0)
+		<< ", \"p999\": " << Percentile(99.9)
+		<< ", \"buckets\": [";
+
+	for (int i = 0; i < NUM_BUCKETS; ++i)
+	{
+		long long inBucket = buckets[i].load(memory_order_relaxed);
+		if (inBucket > 0)
+		{
+			out << (first ? "" : ", ") << "[" << BucketValue(i) << ", " << inBucket << "]";
+			first = false;
+
+		}//end if
+
+	}//end for
+
+	out << "]}";
+	return out.str();
+
+}//end ToJson
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: nanos has been recorded for op in the histogram of the calling thread. lock free after the first
+//		call on each thread
+void LatencyHistogramClass::RecordLatency(	/*in*/LatencyOpType op,		//operation timed
+											/*in*/long long nanos)		//latency in nanoseconds
+{
+	if (mine == nullptr)
+	{
+		mine = new ThreadHistograms;
+
+		lock_guard<mutex> guard(registryLock);
+		registry.push_back(mine);
+
+	}//end if
+
+	mine->ops[op].Record(nanos);
+
+}//end RecordLatency
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: returns the histograms of every thread (live or finished) for op merged into one
+LatencyHistogramClass LatencyHistogramClass::Snapshot(/*in*/LatencyOpType op) //operation to report
+{
+	LatencyHistogramClass merged;
+	lock_guard<mutex> guard(registryLock);
+
+	for (size_t i = 0; i < registry.size(); ++i)
+	{
+		merged.Merge(registry[i]->ops[op]);
+
+	}//end for
+
+	return merged;
+
+}//end Snapshot
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: returns every operation's merged histogram as one JSON object keyed by operation name
+string LatencyHistogramClass::SnapshotJson()
+{
+	string out = "{";
+
+	for (int op = 0; op < NUM_LATENCY_OPS; ++op)
+	{
+		out += (op > 0 ? ", \"" : "\"");
+		out += opNames[op];
+		out += "\": ";
+		out += Snapshot((LatencyOpType)op).ToJson();
+
+	}//end for
+
+	return out + "}";
+
+}//end SnapshotJson
+
+
+/*****************************************************************************************************/
+
+//Pre: no thread is recording
+//Post: every thread's histograms have been cleared
+void LatencyHistogramClass::ResetAll()
+{
+	lock_guard<mutex> guard(registryLock);
+
+	for (size_t i = 0; i < registry.size(); ++i)
+	{
+		for (int op = 0; op < NUM_LATENCY_OPS; ++op)
+		{
+			registry[i]->ops[op].Clear();
+
+		}//end for
+
+	}//end for
+
+}//end ResetAll
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: returns the bucket nanos falls in
+int LatencyHistogramClass::BucketOf(/*in*/long long nanos) //latency in nanoseconds
+{
+	//values below 2 * SUB_BUCKETS are exact. above that, shift the value until it fits in [32, 64) and use
+	//the shifted value to pick one of the 32 buckets of that power of two
+
+	if (nanos < 0)
+	{
+		nanos = 0;
+
+	}//end if
+
+	int shift = 0;
+	while ((nanos >> shift) >= 2 * SUB_BUCKETS && shift < MAX_SHIFT)
+	{
+		++shift;
+
+	}//end while
+
+	long long sub = nanos >> shift;
+	if (sub >= 2 * SUB_BUCKETS)
+	{
+		sub = 2 * SUB_BUCKETS - 1;
+
+	}//end if
+
+	return shift * SUB_BUCKETS + (int)sub;
+
+}//end BucketOf
+
+
+/*****************************************************************************************************/
+
+//Pre: 0 <= bucket < NUM_BUCKETS
+//Post: returns the largest value that falls in bucket
+long long LatencyHistogramClass::BucketValue(/*in*/int bucket) //bucket index
+{
+	if (bucket < 2 * SUB_BUCKETS)
+	{
+		return bucket;
+
+	}//end if
+
+	int shift = bucket / SUB_BUCKETS - 1;
+	long long sub = bucket % SUB_BUCKETS + SUB_BUCKETS;
+	return ((sub + 1) << shift) - 1;
+
+}//end BucketValue
@@ -0,0 +1,205 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: LatencyHistogram.h
+Purpose: Provides the specification for the latency histograms kept around the public OrdListClass operations.
+		A histogram uses HDR style log-linear buckets: values below 64ns get a bucket each, every power of two
+		above that is cut into 32 buckets, so any recorded value is reported within about 3%. Each thread
+		records into histograms of its own, so recording never takes a lock. Snapshots merge the histograms
+		of every thread. OrdListClass only times its operations when compiled with ORDLIST_LATENCY defined.
+Input: All input is done via client
+Output: Percentiles and JSON
+Assumptions: Latencies are in nanoseconds. Values above 2^41ns (about 36 minutes) land in the last bucket.
+*/
+
+#ifndef LATENCY_HISTOGRAM
+#define LATENCY_HISTOGRAM
+
+#include <atomic>
+#include <string>
+
+using namespace std;
+
+//operations that are timed
+enum LatencyOpType
+{
+	OP_FIND,
+	OP_INSERT,
+	OP_DELETE,
+	OP_NEXT_POSITION,
+	OP_UNION,
+	OP_PRINT_FILE,
+	NUM_LATENCY_OPS
+};
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+LatencyHistogramClass();
+	a new empty histogram has been created
+
+LatencyHistogramClass(const LatencyHistogramClass& orig);
+	creates a copy of orig
+
+void Record(long long nanos);
+	nanos has been counted in its bucket. Only one thread may record into a histogram
+
+void Merge(const LatencyHistogramClass& other);
+	every value recorded in other has been added to the current histogram
+
+void Clear();
+	every bucket has been set back to zero
+
+long long ReturnCount() const;
+	returns the number of values recorded to the caller
+
+long long Percentile(double percent) const;
+	returns the smallest bucket value that at least percent % of the recorded values are at or below
+
+string ToJson() const;
+	returns the count, min, max, mean, common percentiles and every non empty bucket as a JSON object
+
+static void RecordLatency(LatencyOpType op, long long nanos);
+	nanos has been recorded for op in the histogram of the calling thread. lock free
+
+static LatencyHistogramClass Snapshot(LatencyOpType op);
+	returns the histograms of every thread for op merged into one
+
+static string SnapshotJson();
+	returns every operation's merged histogram as one JSON object keyed by operation name
+
+static void ResetAll();
+	every thread's histograms have been cleared
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+static int BucketOf(long long nanos);
+	returns the bucket nanos falls in
+
+static long long BucketValue(int bucket);
+	returns the largest value that falls in bucket
+*/
+
+class LatencyHistogramClass
+{
+
+public:
+
+	static const int NUM_BUCKETS = 1184;	//64 exact buckets, then 32 per power of two up to 2^41
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: a new empty histogram has been created
+	LatencyHistogramClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: orig is a valid LatencyHistogramClass
+	//Post: creates a copy of orig
+	LatencyHistogramClass(/*in*/const LatencyHistogramClass& orig); //histogram to copy
+
+	/*****************************************************************************************************/
+
+	//Pre: LatencyHistogramClass has been instantiated, no other thread records into it
+	//Post: nanos has been counted in its bucket. readers on other threads may look at the histogram meanwhile
+	void Record(/*in*/long long nanos); //latency in nanoseconds
+
+	/*****************************************************************************************************/
+
+	//Pre: LatencyHistogramClass has been instantiated
+	//Post: every value recorded in other has been added to the current histogram
+	void Merge(/*in*/const LatencyHistogramClass& other); //histogram to add
+
+	/*****************************************************************************************************/
+
+	//Pre: LatencyHistogramClass has been instantiated
+	//Post: every bucket has been set back to zero
+	void Clear();
+
+	/*****************************************************************************************************/
+
+	//Pre: LatencyHistogramClass has been instantiated
+	//Post: returns the number of values recorded to the caller
+	long long ReturnCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: LatencyHistogramClass has been instantiated, 0 <= percent <= 100
+	//Post: returns the smallest bucket value that at least percent % of the recorded values are at or below.
+	//		0 if the histogram is empty
+	long long Percentile(/*in*/double percent) const; //e.g. 99.9 for p999
+
+	/*****************************************************************************************************/
+
+	//Pre: LatencyHistogramClass has been instantiated
+	//Post: returns the count, min, max, mean, p50, p90, p99, p999 and every non empty bucket (as
+	//		[largest value, count] pairs, so exported histograms can be merged again) as a JSON object
+	string ToJson() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: nanos has been recorded for op in the histogram of the calling thread. lock free after the first
+	//		call on each thread
+	static void RecordLatency(	/*in*/LatencyOpType op,		//operation timed
+								/*in*/long long nanos);		//latency in nanoseconds
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: returns the histograms of every thread (live or finished) for op merged into one
+	static LatencyHistogramClass Snapshot(/*in*/LatencyOpType op); //operation to report
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: returns every operation's merged histogram as one JSON object keyed by operation name
+	static string SnapshotJson();
+
+	/*****************************************************************************************************/
+
+	//Pre: no thread is recording
+	//Post: every thread's histograms have been cleared
+	static void ResetAll();
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: returns the bucket nanos falls in
+	static int BucketOf(/*in*/long long nanos); //latency in nanoseconds
+
+	/*****************************************************************************************************/
+
+	//Pre: 0 <= bucket < NUM_BUCKETS
+	//Post: returns the largest value that falls in bucket
+	static long long BucketValue(/*in*/int bucket); //bucket index
+
+	/*****************************************************************************************************/
+
+private:
+
+	//single writer, so plain loads and stores are enough. atomic only so readers see whole values
+	atomic<long long> buckets[NUM_BUCKETS];	//values recorded per bucket
+	atomic<long long> count;				//values recorded
+	atomic<long long> sum;					//sum of the values recorded
+	atomic<long long> minimum;				//smallest value recorded
+	atomic<long long> maximum;				//largest value recorded
+
+};
+
+#endif
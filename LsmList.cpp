@@ -0,0 +1,683 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: LsmList.cpp
+Purpose: Provides the implementation for the write optimized, log structured front end to OrdListClass.
+Input: All input is done via client
+Output: none
+Assumptions: One thread writes and may call Find, the merges run on the pool at the same time.
+*/
+
+
+#include "LsmList.h"
+#include "OrdListADT.h"
+#include "Exceptions.h"
+#include "KeyHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+static const int MAX_RUNS = 32;		//a Flush that leaves more runs than this waits for the merges to catch up
+static const int BLOCK_WORDS = 8;		//64 bit words per Bloom filter block, one cache line
+static const int MAX_PROBES = 7;		//9 bits of the hash per probe, and 64 bits to go round
+static const int EMPTY_SLOT = -1;		//slot of the buffer index that holds no write
+
+//Pre: slots is a power of two in size and has a free slot, position is a write of buffer
+//Post: the slot of the key of buffer[position] names position, replacing an older write of the same key
+static void PlaceWrite(	/*inout*/vector<int>& slots,				//buffer index
+						/*in*/const vector<LsmEntry>& buffer,		//writes
+						/*in*/int position)							//write to place
+{
+	size_t mask = slots.size() - 1;
+	size_t slot = (size_t)Mix((unsigned long long)buffer[position].item.key) & mask;
+
+	while (slots[slot] != EMPTY_SLOT && buffer[slots[slot]].item.key != buffer[position].item.key)
+	{
+		slot = (slot + 1) & mask;		//linear probing, the table is at most half full
+
+	}//end while
+
+	slots[slot] = position;
+
+}//end PlaceWrite
+
+
+/*****************************************************************************************************/
+
+//Pre: the filter of run was made by BuildFilter
+//Post: returns false to the caller if key was certainly never added to the filter, true if it may have been
+static bool MayContain(	/*in*/const LsmRun& run,	//run whose filter to ask
+						/*in*/KeyType key)			//key to test
+{
+	//blocked Bloom filter: a second mix of the hash picks one 512 bit block (a cache line), and every probe
+	//stays inside it, so a lookup costs one cache miss however many probes there are
+
+	unsigned long long hash = Mix((unsigned long long)key);
+	const unsigned long long* block = run.bits.data() + (((Mix(hash) >> 32) * (run.bits.size() / BLOCK_WORDS)) >> 32) * BLOCK_WORDS;
+
+	for (int i = 0; i < run.probes; ++i)
+	{
+		unsigned bit = (unsigned)(hash >> (9 * i)) & (BLOCK_WORDS * 64 - 1);
+
+		if ((block[bit >> 6] & (1ull << (bit & 63))) == 0)
+		{
+			return false;
+
+		}//end if
+
+	}//end for
+
+	return true;
+
+}//end MayContain
+
+
+/*****************************************************************************************************/
+
+//Pre: run.entries is final
+//Post: run's Bloom filter holds every key of run.entries with about rate false positives: 1.44 * log2(1 / rate)
+//		bits per key (a little more, blocks cost some accuracy), ln 2 times as many probes, at most MAX_PROBES
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+static void BuildFilter(/*inout*/LsmRun& run,		//run to build the filter for
+						/*in*/double rate)			//false positive rate wanted
+{
+	double bitsPerKey = -log(rate) / (log(2.0) * log(2.0)) * 1.2;
+	size_t blocks = (size_t)(bitsPerKey * run.entries.size() / (BLOCK_WORDS * 64)) + 1;
+
+	run.bits.assign(blocks * BLOCK_WORDS, 0);
+	run.probes = (int)(bitsPerKey / 1.2 * log(2.0) + 0.5);
+	if (run.probes < 1)
+	{
+		run.probes = 1;
+
+	}//end if
+
+	if (run.probes > MAX_PROBES)
+	{
+		run.probes = MAX_PROBES;
+
+	}//end if
+
+	for (size_t i = 0; i < run.entries.size(); ++i)
+	{
+		unsigned long long hash = Mix((unsigned long long)run.entries[i].item.key);
+		unsigned long long* block = run.bits.data() + (((Mix(hash) >> 32) * blocks) >> 32) * BLOCK_WORDS;
+
+		for (int p = 0; p < run.probes; ++p)
+		{
+			unsigned bit = (unsigned)(hash >> (9 * p)) & (BLOCK_WORDS * 64 - 1);
+
+			block[bit >> 6] |= 1ull << (bit & 63);
+
+		}//end for
+
+	}//end for
+
+}//end BuildFilter
+
+
+/*****************************************************************************************************/
+
+//Pre: inputs holds at least one sorted run with one entry per key, oldest first
+//Post: returns a new run with the entries of every input, the newest winning on equal keys, to the caller. If
+//		dropTombstones is true (the inputs hold everything ever written) tombstones are left out, nothing is
+//		left for them to hide. a k-way merge of all the inputs at once, so every entry is copied and added to
+//		the new filter once, however many runs there are. the heads of the inputs are kept in a min-heap, so
+//		each entry costs O(log k) and the merge O(N * log k)
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+static shared_ptr<LsmRun> MergeRuns(	/*in*/const vector<shared_ptr<const LsmRun> >& inputs,	//runs to merge
+										/*in*/bool dropTombstones,		//true to leave tombstones out
+										/*in*/double rate)				//false positive rate of the new filter
+{
+	shared_ptr<LsmRun> result = make_shared<LsmRun>();
+	vector<size_t> next(inputs.size(), 0);		//next[r] is the first entry of inputs[r] not merged yet
+	vector<size_t> heads;						//inputs with entries left, a min-heap on their next key
+	size_t total = 0;
+
+	//the heap puts the run with the smallest next key on top, the newest of them on a tie
+
+	auto later = [&](size_t a, size_t b)
+	{
+		KeyType keyA = inputs[a]->entries[next[a]].item.key;
+		KeyType keyB = inputs[b]->entries[next[b]].item.key;
+
+		return keyB < keyA || (keyA == keyB && a < b);
+	};
+
+	heads.reserve(inputs.size());
+	for (size_t r = 0; r < inputs.size(); ++r)
+	{
+		total += inputs[r]->entries.size();
+		if (!inputs[r]->entries.empty())
+		{
+			heads.push_back(r);
+
+		}//end if
+
+	}//end for
+
+	result->entries.reserve(total);
+	make_heap(heads.begin(), heads.end(), later);
+
+	while (!heads.empty())
+	{
+		const LsmEntry& newest = inputs[heads.front()]->entries[next[heads.front()]];
+		KeyType key = newest.item.key;
+
+		if (!dropTombstones || !newest.tombstone)
+		{
+			result->entries.push_back(newest);
+
+		}//end if
+
+		//step every input holding key past it, older ones lose. each goes back in the heap if it has more
+
+		while (!heads.empty() && inputs[heads.front()]->entries[next[heads.front()]].item.key == key)
+		{
+			pop_heap(heads.begin(), heads.end(), later);
+			if (++next[heads.back()] < inputs[heads.back()]->entries.size())
+			{
+				push_heap(heads.begin(), heads.end(), later);
+
+			}//end if
+
+			else
+			{
+				heads.pop_back();
+
+			}//end else
+
+		}//end while
+
+	}//end while
+
+	BuildFilter(*result, rate);
+	return result;
+
+}//end MergeRuns
+
+
+/*****************************************************************************************************/
+
+//Pre: bufferSize > 0, 0 < falsePositiveRate < 1, pool is nullptr or outlives the list
+//Post: a new empty list has been created that freezes its buffer every bufferSize writes and sizes the
+//		Bloom filter of every run for falsePositiveRate. merges run on pool (nullptr for the default pool)
+LsmListClass::LsmListClass(	/*in*/int bufferSize,				//writes held before the buffer is frozen
+							/*in*/double falsePositiveRate,		//share of absent keys a run filter lets through
+							/*in*/ThreadPoolClass* pool)		//pool the merges run on
+{
+	this->bufferSize = (bufferSize > 0) ? bufferSize : 1;
+	rate = (falsePositiveRate > 0.0 && falsePositiveRate < 1.0) ? falsePositiveRate : 0.01;
+	this->pool = (pool != nullptr) ? pool : ThreadPoolClass::Default();
+	merging = false;
+
+	//the index is at least twice the buffer, so a probe sequence is short and always ends
+	size_t slots = 1;
+	while (slots < 2 * (size_t)this->bufferSize)
+	{
+		slots <<= 1;
+
+	}//end while
+
+	buffer.reserve(this->bufferSize);
+	bufferIndex.assign(slots, EMPTY_SLOT);
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: the background merges have finished and every run has been released
+LsmListClass::~LsmListClass()
+{
+	try
+	{
+		pool->Wait(mergeGroup);
+
+	}//end try
+
+	catch (...)
+	{
+		//a merge that ran out of memory only leaves its runs unmerged, and they are going anyway
+
+	}//end catch
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: newItem has been appended to the buffer and replaces any older item with the same key. a full buffer
+//		is frozen into a run. no search is made, so a write costs O(1) plus its share of the sort
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::Insert(/*in*/ItemType newItem) //item to write
+{
+	LsmEntry temp = { newItem, false };
+
+	buffer.push_back(temp);		//reserved, never reallocates
+	IndexWrite();
+	if ((int)buffer.size() >= bufferSize)
+	{
+		Flush();
+
+	}//end if
+
+}//end Insert
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: a tombstone for key has been appended to the buffer, older items with key are no longer found.
+//		deleting a key that is not there is not an error
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::Delete(/*in*/KeyType key) //key to delete
+{
+	LsmEntry temp;
+
+	temp.item.key = key;
+	temp.tombstone = true;
+	buffer.push_back(temp);
+	IndexWrite();
+	if ((int)buffer.size() >= bufferSize)
+	{
+		Flush();
+
+	}//end if
+
+}//end Delete
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: returns true to the caller and sets item to the newest item with key, false if there is none or a
+//		newer tombstone hides it. looks the key up in the hash index of the buffer, then asks the runs from
+//		newest to oldest, skipping every run whose filter rules the key out
+bool LsmListClass::Find(/*in*/KeyType key,				//key to look up
+						/*out*/ItemType& item) const	//item found
+{
+	size_t mask = bufferIndex.size() - 1;
+
+	for (size_t slot = (size_t)Mix((unsigned long long)key) & mask; bufferIndex[slot] != EMPTY_SLOT; slot = (slot + 1) & mask)
+	{
+		const LsmEntry& write = buffer[bufferIndex[slot]];
+
+		if (write.item.key == key)
+		{
+			item = write.item;
+			return !write.tombstone;
+
+		}//end if
+
+	}//end for
+
+	//the lock only keeps a finishing merge from swapping the runs out underneath the search
+
+	lock_guard<mutex> guard(runLock);
+
+	for (size_t r = runs.size(); r > 0; --r)
+	{
+		const LsmRun& run = *runs[r - 1];
+
+		if (MayContain(run, key))
+		{
+			vector<LsmEntry>::const_iterator found = lower_bound(run.entries.begin(), run.entries.end(), key,
+				[](const LsmEntry& entry, KeyType target) { return entry.item.key < target; });
+
+			if (found != run.entries.end() && found->item.key == key)
+			{
+				item = found->item;
+				return !found->tombstone;
+
+			}//end if
+
+		}//end if
+
+	}//end for
+
+	return false;
+
+}//end Find
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: the buffer has been sorted and frozen into a run, even if it is not full
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::Flush()
+{
+	bool stall;
+
+	if (buffer.empty())
+	{
+		return;
+
+	}//end if
+
+	try
+	{
+		//stable, so the last write of a key is the last of its equal keys, and the one that is kept
+
+		stable_sort(buffer.begin(), buffer.end(),
+			[](const LsmEntry& left, const LsmEntry& right) { return left.item.key < right.item.key; });
+
+		shared_ptr<LsmRun> temp = make_shared<LsmRun>();
+		temp->entries.reserve(buffer.size());
+		for (size_t i = 0; i < buffer.size(); ++i)
+		{
+			if (!temp->entries.empty() && temp->entries.back().item.key == buffer[i].item.key)
+			{
+				temp->entries.back() = buffer[i];
+
+			}//end if
+
+			else
+			{
+				temp->entries.push_back(buffer[i]);
+
+			}//end else
+
+		}//end for
+
+		BuildFilter(*temp, rate);
+
+		lock_guard<mutex> guard(runLock);
+		runs.push_back(temp);
+		stall = ((int)runs.size() > MAX_RUNS);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	buffer.clear();
+	fill(bufferIndex.begin(), bufferIndex.end(), EMPTY_SLOT);
+	ScheduleMerge();
+
+	//writes are coming in faster than the merges finish: let them catch up before reads get any slower
+	if (stall)
+	{
+		pool->Wait(mergeGroup);
+
+	}//end if
+
+}//end Flush
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: the buffer has been flushed, the background merges have finished, and every run has been merged
+//		into one that holds no tombstones. Find then costs one filter check and one binary search
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::Compact()
+{
+	Flush();
+	pool->Wait(mergeGroup);
+
+	//nothing runs in the background now, and only the writer starts merges
+
+	if (runs.empty())
+	{
+		return;
+
+	}//end if
+
+	try
+	{
+		RunPointer merged = MergeRuns(runs, true, rate);
+
+		lock_guard<mutex> guard(runLock);
+		runs.assign(1, merged);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end Compact
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated, list is a valid OrdListClass
+//Post: the writes have been compacted and list holds exactly the live items, built balanced in one pass by
+//		BuildFromSorted (whatever list held before is cleared). the writes stay in the current object
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::Export(/*out*/OrdListClass& list) //list to load
+{
+	ItemType* items = nullptr;
+	int count = 0;
+
+	Compact();
+
+	if (!runs.empty())
+	{
+		count = (int)runs[0]->entries.size();
+
+	}//end if
+
+	try
+	{
+		items = new ItemType[count];
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	for (int i = 0; i < count; ++i)
+	{
+		items[i] = runs[0]->entries[i].item;
+
+	}//end for
+
+	list.BuildFromSorted(items, count, true);
+
+}//end Export
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: returns the number of writes in the buffer to the caller
+int LsmListClass::ReturnBufferCount() const
+{
+	return (int)buffer.size();
+
+}//end ReturnBufferCount
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: returns the number of frozen runs to the caller
+int LsmListClass::ReturnRunCount() const
+{
+	lock_guard<mutex> guard(runLock);
+	return (int)runs.size();
+
+}//end ReturnRunCount
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: returns the number of bytes held by the buffer, the runs and their filters to the caller
+long long LsmListClass::ReturnBytes() const
+{
+	lock_guard<mutex> guard(runLock);
+	long long bytes = (long long)buffer.capacity() * sizeof(LsmEntry) + (long long)bufferIndex.size() * sizeof(int);
+
+	for (size_t i = 0; i < runs.size(); ++i)
+	{
+		bytes += (long long)runs[i]->entries.capacity() * sizeof(LsmEntry);
+		bytes += (long long)runs[i]->bits.size() * sizeof(unsigned long long);
+
+	}//end for
+
+	return bytes;
+
+}//end ReturnBytes
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated, the last write of buffer has not been indexed
+//Post: the last write of buffer has been entered in the buffer index. a buffer that outgrew half the index
+//		(a Flush ran out of memory and left it full) gets an index twice the size
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::IndexWrite()
+{
+	if (2 * buffer.size() > bufferIndex.size())
+	{
+		try
+		{
+			bufferIndex.assign(2 * bufferIndex.size(), EMPTY_SLOT);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			buffer.pop_back();		//the write is undone, the old index still covers the rest
+			throw OutOfMemoryException();
+
+		}//end catch
+
+		for (size_t i = 0; i < buffer.size(); ++i)
+		{
+			PlaceWrite(bufferIndex, buffer, (int)i);		//oldest first, so the newest write of a key wins
+
+		}//end for
+
+		return;
+
+	}//end if
+
+	PlaceWrite(bufferIndex, buffer, (int)buffer.size() - 1);
+
+}//end IndexWrite
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated
+//Post: a background merge has been spawned on the pool unless one is already running
+void LsmListClass::ScheduleMerge()
+{
+	{
+		lock_guard<mutex> guard(runLock);
+		int first;
+		int count;
+
+		if (merging || !PlanMerge(first, count))
+		{
+			return;
+
+		}//end if
+
+		merging = true;
+	}
+
+	pool->Spawn(mergeGroup, [this]() { MergeLoop(); });
+
+}//end ScheduleMerge
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated, the caller is the one background merge
+//Post: runs have been merged until PlanMerge finds nothing due. body of the background task
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void LsmListClass::MergeLoop()
+{
+	//runs are only ever appended while a merge runs, so the ones it took are still at first when it is done
+
+	try
+	{
+		for (;;)
+		{
+			vector<RunPointer> inputs;
+			int first;
+			int count;
+
+			{
+				lock_guard<mutex> guard(runLock);
+				if (!PlanMerge(first, count))
+				{
+					merging = false;
+					return;
+
+				}//end if
+
+				inputs.assign(runs.begin() + first, runs.begin() + first + count);
+			}
+
+			RunPointer merged = MergeRuns(inputs, first == 0, rate);
+
+			lock_guard<mutex> guard(runLock);
+			runs.erase(runs.begin() + first, runs.begin() + first + count);
+			runs.insert(runs.begin() + first, merged);		//fits in the space just freed
+
+		}//end for
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		lock_guard<mutex> guard(runLock);
+		merging = false;
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end MergeLoop
+
+
+/*****************************************************************************************************/
+
+//Pre: LsmListClass has been instantiated, runLock is held
+//Post: returns true to the caller if the newest count runs starting at first are due to be merged: every
+//		one of them is at most twice the size of all newer ones together, so each write is merged
+//		O(log N) times. returns false if fewer than two runs qualify
+bool LsmListClass::PlanMerge(	/*out*/int& first,				//oldest run to merge
+								/*out*/int& count) const		//number of runs to merge
+{
+	int last = (int)runs.size() - 1;
+	long long newer;
+
+	if (last < 1)
+	{
+		return false;
+
+	}//end if
+
+	first = last;
+	newer = (long long)runs[last]->entries.size();
+	while (first > 0 && (long long)runs[first - 1]->entries.size() <= 2 * newer)
+	{
+		--first;
+		newer += (long long)runs[first]->entries.size();
+
+	}//end while
+
+	count = last - first + 1;
+	return (count >= 2);
+
+}//end PlanMerge
@@ -0,0 +1,253 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: LsmList.h
+Purpose: Provides the specification for a write optimized front end to OrdListClass, built like a log
+		structured merge tree. Insert and Delete only append to a small buffer (and its hash index), so a
+		write costs no descent at all. A full buffer is sorted and frozen into an immutable sorted run, and
+		runs of similar size are merged in the background on the thread pool by a k-way merge (the newer item
+		wins on equal keys). A Delete appends a tombstone that hides older items of its key until a merge that
+		reaches the oldest run drops both.
+		Find looks the key up in the hash index of the buffer, then at the runs from newest to oldest. Every
+		run has a Bloom filter, so a run that can not hold the key costs a few bit probes instead of a binary
+		search. Export compacts everything into one run and loads it into an OrdListClass for ordered, cursor
+		based access.
+Input: All input is done via client
+Output: none
+Assumptions: One thread writes (Insert, Delete, Flush, Compact, Export) and may call Find, the merges run on
+		the pool at the same time. Keys are never in more than one item per run.
+*/
+
+#ifndef LSM_LIST
+#define LSM_LIST
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "ItemType.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+class OrdListClass;
+
+//one write: an item, or a tombstone for its key
+struct LsmEntry
+{
+	ItemType item;		//item written, only the key counts for a tombstone
+	bool tombstone;		//true for a Delete
+};
+
+//an immutable sorted run with its Bloom filter
+struct LsmRun
+{
+	vector<LsmEntry> entries;				//sorted by key, one entry per key
+	vector<unsigned long long> bits;		//blocked Bloom filter, BLOCK_WORDS words per block
+	int probes;								//bits set per key
+};
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+LsmListClass(int bufferSize, double falsePositiveRate, ThreadPoolClass* pool);
+	a new empty list has been created that freezes its buffer every bufferSize writes
+
+~LsmListClass();
+	the background merges have finished and every run has been released
+
+void Insert(ItemType newItem);
+	newItem has been appended to the buffer. it replaces any older item with the same key
+
+void Delete(KeyType key);
+	a tombstone for key has been appended to the buffer
+
+bool Find(KeyType key, ItemType& item) const;
+	returns true and the newest item with key to the caller, false if there is none or it was deleted
+
+void Flush();
+	the buffer has been frozen into a run
+
+void Compact();
+	every write has been merged into a single run without tombstones
+
+void Export(OrdListClass& list);
+	list holds exactly the live items, the writes stay in place
+
+int ReturnBufferCount() const;
+	returns the number of writes in the buffer to the caller
+
+int ReturnRunCount() const;
+	returns the number of frozen runs to the caller
+
+long long ReturnBytes() const;
+	returns the number of bytes held by the buffer, the runs and their filters to the caller
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+void IndexWrite();
+	the last write of the buffer has been entered in the buffer index
+
+void ScheduleMerge();
+	a background merge has been started unless one is already running
+
+void MergeLoop();
+	merges runs until no group of them is due, body of the background task
+
+bool PlanMerge(int& first, int& count) const;
+	returns true and the runs that are due to be merged to the caller, false if none are
+*/
+
+class LsmListClass
+{
+
+public:
+
+	/*****************************************************************************************************/
+
+	//Pre: bufferSize > 0, 0 < falsePositiveRate < 1, pool is nullptr or outlives the list
+	//Post: a new empty list has been created that freezes its buffer every bufferSize writes and sizes the
+	//		Bloom filter of every run for falsePositiveRate. merges run on pool (nullptr for the default pool)
+	LsmListClass(	/*in*/int bufferSize,				//writes held before the buffer is frozen
+					/*in*/double falsePositiveRate,		//share of absent keys a run filter lets through
+					/*in*/ThreadPoolClass* pool);		//pool the merges run on
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: the background merges have finished and every run has been released
+	~LsmListClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: newItem has been appended to the buffer and replaces any older item with the same key. a full buffer
+	//		is frozen into a run. no search is made, so a write costs O(1) plus its share of the sort
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void Insert(/*in*/ItemType newItem); //item to write
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: a tombstone for key has been appended to the buffer, older items with key are no longer found.
+	//		deleting a key that is not there is not an error
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void Delete(/*in*/KeyType key); //key to delete
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: returns true to the caller and sets item to the newest item with key, false if there is none or a
+	//		newer tombstone hides it. looks the key up in the hash index of the buffer, then asks the runs from
+	//		newest to oldest, skipping every run whose filter rules the key out
+	bool Find(	/*in*/KeyType key,					//key to look up
+				/*out*/ItemType& item) const;		//item found
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: the buffer has been sorted and frozen into a run, even if it is not full
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void Flush();
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: the buffer has been flushed, the background merges have finished, and every run has been merged
+	//		into one that holds no tombstones. Find then costs one filter check and one binary search
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void Compact();
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated, list is a valid OrdListClass
+	//Post: the writes have been compacted and list holds exactly the live items, built balanced in one pass by
+	//		BuildFromSorted (whatever list held before is cleared). the writes stay in the current object
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void Export(/*out*/OrdListClass& list); //list to load
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: returns the number of writes in the buffer to the caller
+	int ReturnBufferCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: returns the number of frozen runs to the caller
+	int ReturnRunCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: returns the number of bytes held by the buffer, the runs and their filters to the caller
+	long long ReturnBytes() const;
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated, the last write of buffer has not been indexed
+	//Post: the last write of buffer has been entered in the buffer index. a buffer that outgrew half the index
+	//		(a Flush ran out of memory and left it full) gets an index twice the size
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void IndexWrite();
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated
+	//Post: a background merge has been spawned on the pool unless one is already running
+	void ScheduleMerge();
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated, the caller is the one background merge
+	//Post: runs have been merged until PlanMerge finds nothing due. body of the background task
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void MergeLoop();
+
+	/*****************************************************************************************************/
+
+	//Pre: LsmListClass has been instantiated, runLock is held
+	//Post: returns true to the caller if the newest count runs starting at first are due to be merged: every
+	//		one of them is at most twice the size of all newer ones together, so each write is merged
+	//		O(log N) times. returns false if fewer than two runs qualify
+	bool PlanMerge(	/*out*/int& first,				//oldest run to merge
+					/*out*/int& count) const;		//number of runs to merge
+
+	/*****************************************************************************************************/
+
+private:
+
+	typedef shared_ptr<const LsmRun> RunPointer;
+
+	vector<LsmEntry> buffer;			//writes not frozen yet, oldest first
+	vector<int> bufferIndex;			//open addressing table of the newest write of every key in buffer
+	int bufferSize;					//writes held before the buffer is frozen
+	double rate;					//false positive rate of the run filters
+	ThreadPoolClass* pool;			//pool the merges run on
+
+	mutable mutex runLock;			//guards runs and merging
+	vector<RunPointer> runs;		//frozen runs, oldest (and largest) first
+	bool merging;					//true while a background merge is running
+	TaskGroup mergeGroup;			//the background merge, waited on by Compact and the destructor
+
+	//no copies, a merge running in the background belongs to one list
+	LsmListClass(const LsmListClass&);
+	void operator=(const LsmListClass&);
+
+};
+
+#endif
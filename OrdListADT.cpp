@@ -16,20 +16,83 @@ Assumptions: All items are stored by a KeyType key. Currently the KeyType is set
 
 #include "OrdListADT.h"
 #include "Exceptions.h"
-
-
+#include "ThreadPool.h"
+#include "LatencyHistogram.h"
+#include "HashIndex.h"
+#include "CuckooFilter.h"
+
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <mutex>
 
 using namespace std;
 
 struct node
 {
 	ItemType data;
+	PayloadHandle payload = NO_PAYLOAD;	//fits in the padding after data, so a node is no larger for it
 	node *left;
 	node *right;
+	int count = 1;		//copies of the key held (multiset mode), 1 otherwise. data and payload already fill
+						//the first 8 bytes, so this takes a node from 24 to 32 bytes
+	bool inBlock = false;	//carved from a block the list owns, freed with the block. fits in the padding
+};
+
+
+//Hint that a node will be read soon. compiles to nothing where the compiler has no prefetch intrinsic
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define PREFETCH(address) _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address) ((void)0)
+#endif
+
+
+//Operation counters compile to nothing unless ORDLIST_STATS is defined
+#ifdef ORDLIST_STATS
+#define STAT_ADD(counter, amount) (counters.counter += (amount))
+#else
+#define STAT_ADD(counter, amount) ((void)0)
+#endif
+
+
+//Times the rest of the enclosing public function into the latency histogram of op. Only the outermost timed
+//call on a thread is recorded, so the Finds made inside NextPosition do not count as Finds
+struct LatencyTimer
+{
+	LatencyOpType op;
+	bool outermost;
+	chrono::steady_clock::time_point start;
+
+	static int& Depth() { static thread_local int depth = 0; return depth; }
+
+	LatencyTimer(LatencyOpType op) : op(op), outermost(Depth()++ == 0), start(chrono::steady_clock::now()) {}
+	~LatencyTimer()
+	{
+		--Depth();
+		if (outermost)
+			LatencyHistogramClass::RecordLatency(op, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+	}
 };
 
 
+//Latency histograms compile to nothing unless ORDLIST_LATENCY is defined
+#ifdef ORDLIST_LATENCY
+#define TIME_OP(op) LatencyTimer opTimer(op)
+#else
+#define TIME_OP(op) ((void)0)
+#endif
+
+
 /*
 
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -115,6 +178,125 @@ list is a near balanced/complete tree. Since the function creates a new object,
 an empty list was added to an unbalanced list, the returning list will be different even though nothing
 was added to the list
 
+void SetThreadPool(ThreadPoolClass* pool);
+the parallel functions of the current list run on pool. nullptr selects the shared default pool
+
+void ParallelForEach(FunctionType visit) const;
+every item of the list has been visited once, in no particular order, by the threads of the pool
+
+MapType ParallelMapReduce(MapFunctionType map, ReduceFunctionType reduce, MapType identity) const;
+returns the reduction of map over every item of the list to the caller
+
+void ParallelMap(MapFunctionType map, EmitFunctionType emit, bool ordered) const;
+map has been applied to every item in parallel and each result handed to emit, in key order if ordered
+
+void BuildFromSorted(ItemType items[], int length, bool adopt);
+the list holds exactly the length items of the sorted array items, as a balanced tree built in parallel
+
+void BulkLoad(const ItemType items[], int length, DuplicatePolicyType policy);
+the list holds the items of the unsorted array items, duplicates resolved by policy, as a balanced tree
+
+int InsertBatch(const ItemType items[], int length, InsertStatusType status[]);
+every new key of items has been inserted, status says which ones were. returns the number inserted
+
+ListStats Stats() const;
+returns a snapshot of the operation counters and the shape of the tree to the caller
+
+void ResetStats();
+every operation counter has been set back to zero
+
+void SetBalanceMode(BalanceModeType mode, double alpha);
+sets how the list keeps its height in check as keys are inserted and deleted
+
+void Rebalance();
+the tree has been reshaped in place into a complete balanced tree, O(N) time and O(1) extra memory
+
+bool FingerFind(KeyType key);
+Find that starts from the last position found instead of the root, climbing only as far as needed
+
+void FindBatch(const KeyType keys[], int count, bool found[]) const;
+found[i] is true if keys[i] is in the list. the searches advance in lockstep so their cache misses overlap
+
+void LowerBoundBatch(const KeyType keys[], int count, ItemType bounds[], bool hasBound[]) const;
+bounds[i] is the item with the smallest key >= keys[i], hasBound[i] false if there is none
+
+void SetHashIndex(bool enabled, double loadFactor);
+turns the hash side index on or off. with it on, Find answers from the index instead of descending the tree
+
+long long ReturnIndexBytes() const;
+returns the number of bytes held by the hash index, 0 when it is off
+
+void SetFilter(bool enabled, double falsePositiveRate);
+turns the cuckoo filter in front of Find on or off. with it on, most Finds for missing keys skip the tree
+
+long long ReturnFilterBytes() const;
+returns the number of bytes held by the filter, 0 when it is off
+
+void SetPayload(const char* bytes, int size);
+the item at currPos carries a copy of bytes as its payload, kept out of line in the payload arena
+
+PayloadView RetrievePayload() const;
+returns a view of the payload of the item at currPos to the caller, without copying it
+
+InsertStatusType TryInsert(ItemType newItem);
+newItem has been inserted unless its key is already in the list. one descent, never throws for a duplicate
+
+InsertStatusType InsertOrAssign(ItemType newItem);
+newItem has been inserted, or has replaced the item with the same key. one descent, never throws for a duplicate
+
+bool Erase(KeyType key);
+the item with key has been removed in one descent. returns false if there was none
+
+int EraseRange(KeyType low, KeyType high);
+every item with a key in [low, high] has been removed by cutting the range out whole. returns how many
+
+void Split(KeyType key, OrdListClass& greater);
+the items with keys >= key have been moved into greater by relinking nodes, the rest stay. O(H + min(k, N - k))
+
+void Join(OrdListClass& other);
+every item of other has been moved into the current list by relinking nodes. the key ranges must not overlap
+
+bool Floor(KeyType key, ItemType& item) const;
+item is the item with the largest key <= key. returns false if there is none. the list is not changed
+
+bool Ceiling(KeyType key, ItemType& item) const;
+item is the item with the smallest key >= key. returns false if there is none. the list is not changed
+
+bool Predecessor(KeyType key, ItemType& item) const;
+item is the item with the largest key < key. returns false if there is none. the list is not changed
+
+bool Successor(KeyType key, ItemType& item) const;
+item is the item with the smallest key > key. returns false if there is none. the list is not changed
+
+void operator+=(const OrdListClass& rightOp);
+the current list holds the union of its keys and rightOp's keys, reusing its own nodes
+
+void SetMultiset(bool enabled, bool expand);
+a repeated key raises the count of its node instead of being rejected, Delete drops one copy at a time
+
+int Count(KeyType key) const;
+returns the number of copies of key in the list to the caller, 0 if it is not there
+
+int RetrieveCount() const;
+returns the number of copies of the item at currPos to the caller
+
+void DumpFile(string fileName) const;
+the keys have been written to fileName one per line in preorder, the file PrintFile makes with a client
+that writes key << endl, formatted into a large buffer instead of one stream call per key
+
+void LoadFile(string fileName);
+the list holds the keys of fileName. the output of PrintFile or DumpFile is rebuilt into an identical tree
+unless that tree is too deep, then the keys are loaded balanced
+
+void SaveCompressed(string fileName) const;
+the keys have been written to fileName in order, as varint deltas in blocks that decode on their own
+
+void LoadCompressed(string fileName);
+the list holds every key of the compressed file fileName, its blocks decoded in parallel
+
+void LoadCompressedRange(string fileName, KeyType low, KeyType high);
+the list holds the keys of fileName in [low, high]. only the blocks that can hold them are read
+
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 ~                                            ~
 ~              Protected Methods			 ~
@@ -131,7 +313,7 @@ void rDelete(node *&trav);
 given a node pointer, delete the current node maintaining proper order
 when prevPos is a nullptr, currPos is pointing to the root
 
-void rPreOrderTrav(node *rtRoot);
+void rPreOrderTrav(node *rtRoot, const PayloadArenaClass* from);
 does a pre-order traversal of rtRoot and inserts them into the current object
 
 void CreateTree(ItemType items[], OrdListClass& list, int start, int end) const;
@@ -148,6 +330,81 @@ Traverses the list backwards visiting each node. client defines what a "visit" i
 
 bool rFind(KeyType key);
 returns true to the caller if key is found in the current object, false otherwise. wrapped function
+
+ThreadPoolClass* ReturnPool() const;
+returns the pool the parallel functions run on
+
+void Deallocate(node* trav);
+returns trav to the freestore, unless it was carved from a block
+
+void OwnBlock(node* block);
+the list owns block, freed once every list holding its nodes has been cleared
+
+void FreeTree(node* trav);
+every node of the subtree at trav has been deallocated
+
+void InsertMidpoints(const ItemType items[], const int order[], int start, int end, InsertStatusType status[]);
+inserts the items of a sorted range midpoint first, so that a run of sorted keys does not grow a chain
+
+void ScapegoatInsert(KeyType key);
+if the node just inserted for key is too deep, the subtree of its scapegoat ancestor has been rebuilt
+
+node* RebuildSubtree(node* trav);
+relinks the nodes of the subtree at trav into a perfectly balanced subtree and returns its root
+
+void Compress(node* pseudoRoot, int count);
+one Day-Stout-Warren compression pass: count left rotations down the right spine of pseudoRoot
+
+bool Locate(KeyType key);
+Find without any restructuring. currPos is set to the node for key or where it would go, prevPos to its parent
+
+void Splay(KeyType key);
+top-down splay: the node for key, or the last node on its search path, is now the root
+
+void FingerPush(node* trav);
+trav has been pushed on the finger path below its parent, with the key range of its subtree
+
+void SettleCursor();
+prevPos has been set to the parent of currPos if a Find answered from the hash index left it unset
+
+void IndexTree();
+every node of the tree has been entered in the hash index
+
+void IndexNode(node* trav);
+trav has been entered in the hash index, if there is one
+
+void FilterKey(KeyType key);
+key has been added to the filter, if there is one. the filter is rebuilt larger when it is full
+
+void FilterTree(int capacity);
+the filter holds exactly the keys of the tree and has room for capacity keys
+
+InsertStatusType Upsert(ItemType newItem, bool assign);
+shared body of TryInsert and InsertOrAssign
+
+void ReleaseNode(node* trav);
+trav has left the index, filter and payload arena, been deallocated and uncounted
+
+int ReleaseTree(node* trav);
+ReleaseNode has been applied to every node of the unlinked subtree at trav. returns how many
+
+bool HasSideData() const;
+returns true if the list keeps a hash index, a filter or payloads
+
+void CopyOut(node* trav, KeyType key, bool whole, OrdListClass& to, vector<node*>& moved, vector<PayloadHandle>& copies) const;
+the nodes that move to to have been collected and their payloads copied into to's arena, nothing changed yet
+
+void MoveOut(const vector<node*>& moved, const vector<PayloadHandle>& copies);
+the nodes in moved have left the index and filter, their payloads have been swapped for the copies
+
+void MoveIn(const vector<node*>& moved);
+the nodes in moved, now linked into the tree, have been entered in the index and filter
+
+void PrepareLoad(OrdListClass& loaded) const;
+loaded uses the pool, multiset mode, hash index and filter settings of the current list
+
+void FinishLoad(OrdListClass& loaded);
+the tree built in loaded has been swapped into the current list
 */
 
 /*****************************************************************************************************/
@@ -159,6 +416,23 @@ OrdListClass::OrdListClass()
 	root = nullptr;
 	prevPos = nullptr;
 	currPos = nullptr;
+	pool = nullptr;
+	length = 0;
+	ResetStats();
+	balanceMode = BALANCE_NONE;
+	alpha = 0.7;
+	maxLength = 0;
+	version = 0;
+	fingerVersion = 0;
+	hashIndex = nullptr;
+	cursorPending = false;
+	pendingKey = 0;
+	filter = nullptr;
+	payloads = nullptr;
+	multiset = false;
+	expandCopies = false;
+	copyOf = nullptr;
+	copyIndex = 0;
 
 }//end default constructor
 
@@ -170,6 +444,9 @@ OrdListClass::OrdListClass()
 OrdListClass::~OrdListClass()
 {
 	Clear();
+	delete hashIndex;
+	delete filter;
+	delete payloads;
 
 }//end destructor
 
@@ -183,6 +460,35 @@ OrdListClass::OrdListClass(/*in*/const OrdListClass &orig) //object to copy
 	root = nullptr;
 	prevPos = nullptr;
 	currPos = nullptr; 
+	pool = orig.pool;
+	length = 0;
+	ResetStats();
+	balanceMode = orig.balanceMode;
+	alpha = orig.alpha;
+	maxLength = 0;
+	version = 0;
+	fingerVersion = 0;
+	hashIndex = nullptr;
+	cursorPending = false;
+	pendingKey = 0;
+	filter = nullptr;
+	payloads = nullptr;
+	multiset = orig.multiset;
+	expandCopies = orig.expandCopies;
+	copyOf = nullptr;
+	copyIndex = 0;
+
+	if (orig.hashIndex != nullptr)
+	{
+		SetHashIndex(true, orig.hashIndex->ReturnLoadFactor());
+
+	}//end if
+
+	if (orig.filter != nullptr)
+	{
+		SetFilter(true, orig.filter->ReturnFalsePositiveRate());
+
+	}//end if
 
 	operator=(orig);
 
@@ -218,6 +524,7 @@ bool OrdListClass::IsFull() const
 //		the list. This is represented by currPos == prevPos
 bool OrdListClass::EndOfList()
 {
+	SettleCursor();
 	return (currPos==prevPos);
 
 }//end EndOfList
@@ -230,9 +537,13 @@ bool OrdListClass::EndOfList()
 void OrdListClass::FirstPosition()
 {
 
-	//First position is the left most node
+	//First position is the left most node. prevPos may still hold a node from an earlier search, and a
+	//root with no left child would then look like the end of the list
 
+	cursorPending = false;
+	copyOf = nullptr;
 	currPos = root;
+	prevPos = nullptr;
 	if (currPos != nullptr)
 	{
 		while (currPos->left != nullptr)
@@ -250,13 +561,37 @@ void OrdListClass::FirstPosition()
 /*****************************************************************************************************/
 
 //Pre: OrdListClass has been instantiated
-//Post: sets the current position of the list to the next greatest element in the list
+//Post: sets the current position of the list to the next greatest element in the list. with expanded multiset
+//		iteration on, every copy of a key is a position of its own (Retrieve returns the same item for each)
 void OrdListClass::NextPosition()
 {
-	//uses Find to correctly set currPos and prevPos
+	TIME_OP(OP_NEXT_POSITION);
+
+	//uses Locate to correctly set currPos and prevPos (never splays, so the walk does not reshape the tree)
+
+#ifdef ORDLIST_STATS
+	long long findsBefore = counters.findComparisons;	//nodes visited by the Locates below belong to NextPosition
+#endif
+
+	SettleCursor();
+
+	//expanded multiset: stay on the node until every copy of its key has been visited
+	bool nextCopy = false;
+	if (expandCopies && !IsEmpty() && !EndOfList())
+	{
+		int copy = (copyOf == currPos) ? copyIndex : 0;
+
+		nextCopy = (copy + 1 < currPos->count);
+		if (nextCopy)
+		{
+			copyOf = currPos;
+			copyIndex = copy + 1;
+
+		}//end if
 
+	}//end if
 
-	if (!IsEmpty() && !EndOfList())
+	if (!nextCopy && !IsEmpty() && !EndOfList())
 	{
 
 		//To compinsate for last postion... if the current position is the last position in the list, 
@@ -266,6 +601,7 @@ void OrdListClass::NextPosition()
 		while (temp->right != nullptr)
 		{
 			temp = temp->right;
+			STAT_ADD(nextPositionVisits, 1);
 
 		}//end while
 
@@ -282,10 +618,12 @@ void OrdListClass::NextPosition()
 		{
 			prevPos = currPos;
 			currPos = currPos->right;
+			STAT_ADD(nextPositionVisits, 1);
 			while (currPos->left != nullptr)
 			{
 				prevPos = currPos;
 				currPos = currPos->left;
+				STAT_ADD(nextPositionVisits, 1);
 				
 			}//end while
 
@@ -298,7 +636,7 @@ void OrdListClass::NextPosition()
 		{
 			if (prevPos->left == currPos)
 			{
-				Find(prevPos->data.key);
+				Locate(prevPos->data.key);
 
 			}//end if
 
@@ -306,12 +644,12 @@ void OrdListClass::NextPosition()
 			{
 				while (currPos == prevPos->right)
 				{
-					Find(prevPos->data.key);
+					Locate(prevPos->data.key);
 
 				}//end while
 
 				currPos = prevPos;
-				Find(currPos->data.key);
+				Locate(currPos->data.key);
 
 			}//end else
 
@@ -319,6 +657,11 @@ void OrdListClass::NextPosition()
 
 	}//end if
 
+#ifdef ORDLIST_STATS
+	counters.nextPositionVisits += counters.findComparisons - findsBefore;
+	counters.findComparisons = findsBefore;
+#endif
+
 }//end NextPosition
 
 
@@ -330,6 +673,8 @@ void OrdListClass::LastPosition()
 {
 	//Last position is the right most node
 
+	cursorPending = false;
+	copyOf = nullptr;
 	currPos = root;
 
 	while (currPos->right != nullptr)
@@ -350,6 +695,51 @@ void OrdListClass::LastPosition()
 //		found node or where the node would appear in the list
 bool OrdListClass::Find(/*in*/KeyType key) //key type to find
 {
+	TIME_OP(OP_FIND);
+	copyOf = nullptr;
+
+	//filter: a miss it is sure of costs two bucket reads. the parent is only looked up if Insert needs it
+	if (filter != nullptr && !filter->MayContain(key))
+	{
+		STAT_ADD(filterRejects, 1);
+		currPos = nullptr;
+		cursorPending = true;
+		pendingKey = key;
+		return false;
+
+	}//end if
+
+	//index: one probe, and the parent is only looked up if Insert, Delete or the cursor functions need it
+	if (hashIndex != nullptr)
+	{
+		currPos = hashIndex->Find(key);
+		cursorPending = true;
+		pendingKey = key;
+		return (currPos != nullptr);
+
+	}//end if
+
+	cursorPending = false;
+
+	if (balanceMode == BALANCE_SPLAY)
+	{
+		//whatever the search touched last is now the root. on a miss the key would go right beside it
+
+		Splay(key);
+		if (root != nullptr && root->data.key == key)
+		{
+			currPos = root;
+			prevPos = nullptr;
+			return true;
+
+		}//end if
+
+		currPos = nullptr;
+		prevPos = root;
+		return false;
+
+	}//end if
+
 	currPos = root;
 	return rFind(key);
 
@@ -376,30 +766,113 @@ ItemType OrdListClass::Retrieve() const
 /*****************************************************************************************************/
 
 //Pre: OrdListClass has been instantiated , Find has been called to set currPos
-//Post: newItem is inserted into the correct position in the list
+//Post: newItem is inserted into the correct position in the list. in multiset mode a key that is already
+//		in the list has its count raised instead, and currPos is left on it
 //Exceptions thrown: throws a DuplicateKeyException if the caller attempts to insert a item that 
-//					 is already in the list
+//					 is already in the list (unless the list is a multiset)
 bool OrdListClass::Insert(/*in*/ItemType newItem) //item to insert into the list
 {
+	TIME_OP(OP_INSERT);
+
+	//grow the index before anything is linked, so that running out of memory leaves the list as it was
+	if (hashIndex != nullptr)
+	{
+		try
+		{
+			hashIndex->Reserve(length + 1);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			throw OutOfMemoryException();
+
+		}//end catch
 
+	}//end if
+
+	unsigned before = version++;
 
 	//First element in the list
 	if (root == nullptr)
 	{
+		cursorPending = false;
 		root = Allocate();
 		root->data = newItem;
+		currPos = root;
+		prevPos = nullptr;
+		++length;
+		IndexNode(root);
+		FilterKey(newItem.key);
 		return true;
 
 	}//end if
 
+	//splay: split the tree around the new key and make the new node the root
+	else if (balanceMode == BALANCE_SPLAY)
+	{
+		cursorPending = false;
+		Splay(newItem.key);
+		if (root->data.key == newItem.key)
+		{
+			if (!multiset)
+			{
+				throw new DuplicateKeyException();
+
+			}//end if
+
+			++root->count;
+			currPos = root;
+			prevPos = nullptr;
+			return true;
+
+		}//end if
+
+		currPos = Allocate();
+		currPos->data = newItem;
+
+		if (newItem.key < root->data.key)
+		{
+			currPos->left = root->left;
+			currPos->right = root;
+			root->left = nullptr;
+
+		}//end if
+
+		else
+		{
+			currPos->right = root->right;
+			currPos->left = root;
+			root->right = nullptr;
+
+		}//end else
+
+		root = currPos;
+		prevPos = nullptr;
+		++length;
+		IndexNode(currPos);
+		FilterKey(newItem.key);
+		return true;
+
+	}//end else if
+
 	//currPos should point to null here 
 	//Find has already been called and currPos points to where the new element should go. If the element
 	//was found in the list, currPos will not point to null
 	else
 	{
+		SettleCursor();
+
 		if (currPos != nullptr)
 		{
-			throw new DuplicateKeyException();
+			if (!multiset)
+			{
+				throw new DuplicateKeyException();
+
+			}//end if
+
+			++currPos->count;		//no node is allocated for a repeat
+			return true;
 
 		}//end if
 
@@ -418,6 +891,24 @@ bool OrdListClass::Insert(/*in*/ItemType newItem) //item to insert into the list
 
 		}//end else
 
+		++length;
+		IndexNode(currPos);
+		FilterKey(newItem.key);
+
+		//the finger path ended at the new node's parent, so extending it keeps it valid
+		if (fingerVersion == before && !finger.empty() && finger.back().trav == prevPos)
+		{
+			FingerPush(currPos);
+			fingerVersion = version;
+
+		}//end if
+
+		if (balanceMode == BALANCE_SCAPEGOAT)
+		{
+			ScapegoatInsert(newItem.key);
+
+		}//end if
+
 		return true;
 
 	}//end else
@@ -431,11 +922,38 @@ bool OrdListClass::Insert(/*in*/ItemType newItem) //item to insert into the list
 
 //Pre: OrdListClass has been instantiated, Find has been called to set currPos to the element that needs
 //		to be deleted
-//Post: the element at currPos has been removed from the list
+//Post: the element at currPos has been removed from the list. in multiset mode (or while the item
+//		still has copies) one copy is dropped, and the node only goes with the last one
 void OrdListClass::Delete()
 {
+	TIME_OP(OP_DELETE);
+	SettleCursor();
+
+	//a multiset drops one copy at a time, the node only goes with the last one
+	if (currPos->count > 1)
+	{
+		--currPos->count;
+		return;
+
+	}//end if
+
+	copyOf = nullptr;
+	++version;
+	if (filter != nullptr)
+	{
+		filter->Erase(currPos->data.key);
+
+	}//end if
+
 	rDelete(currPos);
 
+	//scapegoat: once enough keys are gone the bound no longer holds for the old size, rebuild everything
+	if (balanceMode == BALANCE_SCAPEGOAT && length < alpha * maxLength)
+	{
+		Rebalance();
+
+	}//end if
+
 }//end Delete
 
 
@@ -445,13 +963,34 @@ void OrdListClass::Delete()
 //Post: all elements have been removed from the list. All memory from nodes have been returned to freestore
 void OrdListClass::Clear()
 {
-	//while list is not empty, delete the smallest node
-	while (root != nullptr)
+	//free every node in one walk instead of deleting the smallest node over and over
+
+	++version;
+	FreeTree(root);
+	nodeBlocks.clear();		//after the tree, which may still hold nodes of the blocks
+	if (hashIndex != nullptr)
 	{
-		FirstPosition();
-		Delete();
+		hashIndex->Clear();
 
-	}//end while
+	}//end if
+
+	if (filter != nullptr)
+	{
+		filter->Clear();
+
+	}//end if
+
+	if (payloads != nullptr)
+	{
+		payloads->Clear();
+
+	}//end if
+
+	root = nullptr;
+	currPos = nullptr;
+	prevPos = nullptr;
+	length = 0;
+	maxLength = 0;
 
 }//end Clear
 
@@ -462,11 +1001,9 @@ void OrdListClass::Clear()
 //Post: returns the length of the current list to the caller
 int OrdListClass::ReturnLength() const
 {
-	//TODO: header record for root?? O(n) runtime for getlength...
+	//kept up to date by every function that links or unlinks a node
 
-	int count = 0;
-	rLength(root, count);
-	return count;
+	return length;
 
 }//end ReturnLength
 
@@ -490,6 +1027,7 @@ void OrdListClass::PrintScreen(/*inout*/FunctionType visit) //function pointer.
 void OrdListClass::PrintFile(/*inout*/FunctionTypeFile visit,	//function pointer that passes control back to client. contains an ofstream 
 							 /*inout*/string fileName)			//filename to write the data to
 {
+	TIME_OP(OP_PRINT_FILE);
 	ofstream outdat(fileName);
 	rFileTrav(visit, root, outdat);
 
@@ -520,12 +1058,14 @@ void OrdListClass::PrintAsExists(/*inout*/FunctionType visit) //function pointer
 /*****************************************************************************************************/
 
 //Pre: OrdListClass has been instantiated, rightOp is a valid OrdListClass
-//Post: current object is identical to rightOp
+//Post: current object is identical to rightOp, multiset mode and counts included
 void OrdListClass::operator=(/*in*/const OrdListClass& rightOp) //object to be copied
 {
 	Clear();
+	multiset = rightOp.multiset;		//the counts copied below only mean something with the mode that made them
+	expandCopies = rightOp.expandCopies;
 	node *rtRoot = rightOp.root;
-	rPreOrderTrav(rtRoot);
+	rPreOrderTrav(rtRoot, rightOp.payloads);
 
 	currPos = rightOp.currPos;
 	prevPos = rightOp.prevPos;
@@ -536,7 +1076,8 @@ void OrdListClass::operator=(/*in*/const OrdListClass& rightOp) //object to be c
 /*****************************************************************************************************/
 
 //Pre: OrdListClass has been instantiated, rightOp is a valid OrdListClass
-//Post: returns true to the caller if current objects keys are identical to rightOp, false otherwise
+//Post: returns true to the caller if current objects keys (and the counts of a multiset) are identical to
+//		rightOp, false otherwise
 bool OrdListClass::operator==(/*in*/const OrdListClass& rightOp) const //object to compare to
 {
 	//Need to set their roots back to null right before the return statement because the left and right lists point
@@ -546,6 +1087,7 @@ bool OrdListClass::operator==(/*in*/const OrdListClass& rightOp) const //object
 	OrdListClass leftList; OrdListClass rightList;
 
 	leftList.root = root; rightList.root = rightOp.root;
+	leftList.length = length; rightList.length = rightOp.length;
 
 
 	//If the lists do not have the same length, stop here
@@ -564,7 +1106,8 @@ bool OrdListClass::operator==(/*in*/const OrdListClass& rightOp) const //object
 
 		while (!leftList.EndOfList())
 		{
-			if (leftList.currPos->data.key != rightList.currPos->data.key)
+			if (leftList.currPos->data.key != rightList.currPos->data.key
+				|| leftList.currPos->count != rightList.currPos->count)		//{1, 1} is not {1}
 			{
 				leftList.root = nullptr; rightList.root = nullptr;
 				return false;
@@ -606,9 +1149,11 @@ bool OrdListClass::operator!=(/*in*/const OrdListClass& rightOp) const //object
 //Post: returns a new OrdListClass with the union of the current objects keys and rightOp's keys. The new
 //		list is a near balanced/complete tree. Since the function creates a new object, and balances it, if 
 //		an empty list was added to an unbalanced list, the returning list will be different even though nothing
-//		was added to the list
+//		was added to the list. if either list is a multiset the result is one, and counts of shared keys add up
 OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //object to union
 {
+	TIME_OP(OP_UNION);
+
 	//For operator+ I copy both lists into temporary OrdListClasses. Then, go through each element in the list adding them to a
 	//dynamic array of ItemTypes (in order). Then, passing the array and number of elements into a helper function, an OrdListClass 
 	//is created using the sorted array using a modifed binary search
@@ -619,11 +1164,66 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 	ItemType left; ItemType right; //current Items
 	int index = 0;					//number of items in new tree
 
+	//leftList and rightList only borrow the nodes and arenas of the operands. On every way out of here, the
+	//guard hands them back before the temporaries are destroyed and frees the buffers, so an exception can
+	//not free the operands along with the temporaries
+	struct BorrowGuard
+	{
+		OrdListClass* lists[2];		//temporaries holding borrowed pointers
+		ItemType* items;			//until BuildFromSorted takes it over
+		PayloadView* views;
+		int* counts;
+
+		~BorrowGuard()
+		{
+			for (int i = 0; i < 2; ++i)
+			{
+				lists[i]->root = nullptr;
+				lists[i]->payloads = nullptr;
+				lists[i]->length = 0;
 
+			}//end for
+
+			delete[] items;
+			delete[] views;
+			delete[] counts;
+		}
+	} guard = { { &leftList, &rightList }, nullptr, nullptr, nullptr };
 
 	leftList.root = root; rightList.root = rightOp.root;
+	leftList.length = length; rightList.length = rightOp.length;
+	leftList.payloads = payloads; rightList.payloads = rightOp.payloads;
 	int leftLen = leftList.ReturnLength(); int rightLen = rightList.ReturnLength();
-	ItemType* items = new ItemType[leftLen + rightLen]; //dynamic array (unknown tree sizes)
+
+	try
+	{
+		guard.items = new ItemType[leftLen + rightLen]; //dynamic array (unknown tree sizes)
+
+		//payloads travel with their items: views are collected in the same order and copied once result exists
+		if (payloads != nullptr || rightOp.payloads != nullptr)
+		{
+			guard.views = new PayloadView[leftLen + rightLen];
+
+		}//end if
+
+		//so do the counts of a multiset. where both lists have a key its counts add up
+		if (multiset || rightOp.multiset)
+		{
+			guard.counts = new int[leftLen + rightLen];
+
+		}//end if
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	ItemType* items = guard.items;
+	PayloadView* views = guard.views;
+	int* counts = guard.counts;
 
 	leftList.FirstPosition(); rightList.FirstPosition();
 
@@ -638,6 +1238,8 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 		if (left.key < right.key) 
 		{
 			items[index] = left;
+			if (views != nullptr) views[index] = leftList.RetrievePayload();
+			if (counts != nullptr) counts[index] = leftList.RetrieveCount();
 			leftList.NextPosition();
 
 		}//end if
@@ -645,6 +1247,8 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 		else if (left.key > right.key)
 		{
 			items[index] = right;
+			if (views != nullptr) views[index] = rightList.RetrievePayload();
+			if (counts != nullptr) counts[index] = rightList.RetrieveCount();
 			rightList.NextPosition();
 
 		}//end else if
@@ -652,6 +1256,8 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 		else
 		{
 			items[index] = left;
+			if (views != nullptr) views[index] = leftList.RetrievePayload();
+			if (counts != nullptr) counts[index] = leftList.RetrieveCount() + rightList.RetrieveCount();
 			rightList.NextPosition();
 			leftList.NextPosition();
 
@@ -669,6 +1275,8 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 		{
 			right = rightList.Retrieve();
 			items[index] = right;
+			if (views != nullptr) views[index] = rightList.RetrievePayload();
+			if (counts != nullptr) counts[index] = rightList.RetrieveCount();
 			rightList.NextPosition();
 			++index;
 
@@ -682,6 +1290,8 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 		{
 			left = leftList.Retrieve();
 			items[index] = left;
+			if (views != nullptr) views[index] = leftList.RetrievePayload();
+			if (counts != nullptr) counts[index] = leftList.RetrieveCount();
 			leftList.NextPosition();
 			++index;
 
@@ -690,357 +1300,4808 @@ OrdListClass OrdListClass::operator+(/*in*/const OrdListClass& rightOp) const //
 	}//end else if
 
 
-	//Create a balanced tree
-	CreateTree(items, result, 0, index - 1);
+	//Create a balanced tree (the list takes over items, and frees it even if it throws)
+	guard.items = nullptr;
+	result.BuildFromSorted(items, index, true);
 
-	//clear root pointers
-	leftList.root = nullptr; rightList.root = nullptr;
+	//the nodes of result are in the same order as views and counts. in order walk with a stack, the tree is balanced
+	result.multiset = (counts != nullptr);
+	result.expandCopies = result.multiset && expandCopies;
+	if (views != nullptr || counts != nullptr)
+	{
+		vector<node*> pending;
+		node* trav = result.root;
+		int i = 0;
 
-	return result;
+		while (trav != nullptr || !pending.empty())
+		{
+			while (trav != nullptr)
+			{
+				pending.push_back(trav);
+				trav = trav->left;
 
-}//end operator+
+			}//end while
 
+			trav = pending.back();
+			pending.pop_back();
 
-/*****************************************************************************************************/
+			if (views != nullptr && views[i].data != nullptr)
+			{
+				result.currPos = trav;
+				result.SetPayload(views[i].data, views[i].size);
 
-//Pre: OrdListClass has been instantiated
-//Post: returns a new node pointer to the caller with all values set to nullptr
-//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap
-node* OrdListClass::Allocate()
-{
-	try
-	{
-		node* temp = new node;
-		temp->left = nullptr;
-		temp->right = nullptr;
-		return temp;
+			}//end if
 
-	}//end try
+			if (counts != nullptr)
+			{
+				trav->count = counts[i];
 
-	catch (bad_alloc*)
-	{
-		throw new OutOfMemoryException;
+			}//end if
 
-	}//end catch
+			++i;
+			trav = trav->right;
 
-}//end Allocate
+		}//end while
 
-
-/*****************************************************************************************************/
-
-//wrapped function
-//Pre: OrdListClass has been instantiated, trav is the root
-//Post: traverses the list and returns the number of elements to the caller
-int OrdListClass::rLength(/*in*/node *trav,				//starting node
-						 /*inout*/int &numNodes) const	//number of nodes in the tree
-{
-	if (trav != nullptr)				
-	{
-		numNodes++;						//increment counter
-		rLength(trav->left, numNodes);	//go left
-		rLength(trav->right, numNodes);	//go right
+		result.currPos = result.root;
 
 	}//end if
 
-	return numNodes;
+	return result;
 
-}//end rLength
+}//end operator+
 
 
 /*****************************************************************************************************/
 
-//Pre: Find has been called on the node that needs to be deleted. OrdListClass has been instantiated
-//Post: given a node pointer, delete the current node maintaining proper order
-//when prevPos is a nullptr, currPos is pointing to the root
-//wrapped function (sort of) will only call itself at most one additional time
-void OrdListClass::rDelete(/*inout*/node *&trav)  //node to delete from the current object
+//Pre: OrdListClass has been instantiated, pool is nullptr or outlives the list
+//Post: the parallel functions of the current list run on pool. nullptr selects the shared default pool.
+//		one pool may be shared by any number of lists
+void OrdListClass::SetThreadPool(/*in*/ThreadPoolClass* pool) //pool to run on
 {
-	if (trav->left == nullptr && trav->right == nullptr) //no children
-	{
-		if (trav != root)			//no children, and at the root therefore the root is the only node left in the tree, need to delete that node so go to else..
-		{
-			if (prevPos->left == trav)
-			{
-				prevPos->left = nullptr;
-
-			}//end if
-
-			else
-			{
-				prevPos->right = nullptr;
-
-			}//end else
-
-		}//end if
+	this->pool = pool;
 
-		else
-		{
-			root = nullptr;
-			prevPos = nullptr;
+}//end SetThreadPool
 
-		}//end else
 
-		delete trav;
-		trav = root;
+/*****************************************************************************************************/
 
-	}//end if
+//Pre: trav is not null, group belongs to pool, proto is the worker every task starts from
+//Post: every node of the subtree at trav has been handed to a copy of proto. Whenever a worker of the pool
+//		runs dry, the next pending subtree is handed to it instead of being walked here (lazy splitting, so even
+//		a lopsided tree keeps every worker busy)
+template <class WorkerType>
+static void ParallelWalk(	/*in*/node* trav,				//root of the subtree to walk
+							/*in*/ThreadPoolClass* pool,	//pool to shed work to
+							/*inout*/TaskGroup* group,		//group of the whole traversal
+							/*in*/const WorkerType* proto)	//worker to copy
+{
+	WorkerType worker(*proto);
+	vector<node*> pending;
 
-	else if (trav->left != nullptr && trav->right == nullptr) //Node we are trying to delete has a left child
+	pending.push_back(trav);
+	while (!pending.empty())
 	{
-		node *temp = trav;
+		node* temp = pending.back();
+		pending.pop_back();
 
-		if (trav != root)
+		worker.Visit(temp->data);
+
+		node* children[2] = { temp->right, temp->left };
+		for (int i = 0; i < 2; ++i)
 		{
-			if (prevPos->left == trav) //finding its parent to link together
+			node* child = children[i];
+			if (child != nullptr)
 			{
-				prevPos->left = trav->left;
+				if (pool->IsHungry())
+				{
+					pool->Spawn(*group, [child, pool, group, proto]() { ParallelWalk(child, pool, group, proto); });
 
-			}//end if
+				}//end if
 
-			else
-			{
-				prevPos->right = trav->left;
+				else
+				{
+					pending.push_back(child);
 
-			}//end else
+				}//end else
 
-		}//end if
+			}//end if
 
-		else
-		{
-			root = trav->left;
-			prevPos = nullptr;
+		}//end for
 
-		}//end else
+	}//end while
 
-		trav = root;
-		delete temp;
+	worker.Finish();
 
-	}//end else if
+}//end ParallelWalk
 
-	else if (trav->left == nullptr && trav->right != nullptr) //node we are trying to delete has a right child
-	{
-		node *temp = trav;
 
-		if (trav != root)
-		{
-			if (prevPos->left == trav)
-			{
-				prevPos->left = trav->right;
+//worker for ParallelForEach
+struct ForEachWorker
+{
+	FunctionType visit;
 
-			}//end if
+	void Visit(const ItemType& item) { visit(item); }
+	void Finish() {}
+};
 
-			else
-			{
-				prevPos->right = trav->right;
 
-			}//end else
+//worker for ParallelMapReduce. each task reduces locally and combines into the shared total once at the end
+struct ReduceWorker
+{
+	MapFunctionType map;
+	ReduceFunctionType reduce;
+	MapType local;
+	MapType* total;
+	mutex* totalLock;
+
+	void Visit(const ItemType& item) { local = reduce(local, map(item)); }
+	void Finish() { lock_guard<mutex> guard(*totalLock); *total = reduce(*total, local); }
+};
 
-		}//end if
 
-		else
-		{
-			root = trav->right;
-			prevPos = nullptr;
+//worker for the unordered ParallelMap
+struct MapWorker
+{
+	MapFunctionType map;
+	EmitFunctionType emit;
 
-		}//end else
+	void Visit(const ItemType& item) { emit(item, map(item)); }
+	void Finish() {}
+};
 
-		trav = root;
-		delete temp;
 
-	}//end else if
+//Pre: trav is the root of a subtree
+//Post: the nodes of the subtree have been appended to out, in key order
+static void ListInOrder(	/*in*/node* trav,				//root of the subtree
+							/*inout*/vector<node*>* out)	//nodes in key order
+{
+	vector<node*> path;
 
-	else //node has two children. need to find in order precursor, copy its value, then process delete on the node that was copied
+	while (trav != nullptr || !path.empty())
 	{
-		node *temp = trav;
-		trav = trav->right;
-
-		while (trav->left != nullptr)
+		while (trav != nullptr)
 		{
+			path.push_back(trav);
 			trav = trav->left;
 
 		}//end while
 
-		Find(trav->data.key); //to set prev pos
-		temp->data = trav->data;
-		rDelete(trav);
+		trav = path.back();
+		path.pop_back();
+		out->push_back(trav);
+		trav = trav->right;
 
-	}//end else
+	}//end while
 
-}//end rDelete
+}//end ListInOrder
 
 
 /*****************************************************************************************************/
 
-//Pre: rtRoot is a valid root of a tree, OrdListClass has been instantiated
-//Post: does a pre-order traversal of rtRoot and inserts them into the current object
-void OrdListClass::rPreOrderTrav(/*in*/node *rtRoot) //root of tree to copy
+//Pre: OrdListClass has been instantiated, visit is a valid FunctionType that is safe to call from several
+//		threads at once
+//Post: every item of the list has been visited once, in no particular order, by the threads of the pool.
+//		subtrees are handed to idle workers as they become hungry, so the work stays balanced
+void OrdListClass::ParallelForEach(/*in*/FunctionType visit) const //function pointer. passes control back to client
 {
-	if (rtRoot != nullptr)
+	if (root != nullptr)
 	{
-		Find(rtRoot->data.key);
-		Insert(rtRoot->data);
-		rPreOrderTrav(rtRoot->left);
-		rPreOrderTrav(rtRoot->right);
+		ThreadPoolClass* workPool = ReturnPool();
+		TaskGroup group;
+		ForEachWorker proto = { visit };
+		WaitGuard guard(workPool, group);
+
+		ParallelWalk(root, workPool, &group, &proto);
+		workPool->Wait(group);
 
 	}//end if
 
-}//end rPreOrderTrav
+}//end ParallelForEach
 
 
 /*****************************************************************************************************/
 
-//Pre: items is an ordered array with ItemTypes to be added to list
-//		list is a valid OrdListClass
-//		start is the starting index of the search (init 0) 
-//		end is the end of the search (init items.size)
-//Post: creates a BST from an ordered list of data and returns it to the caller by ref
-void OrdListClass::CreateTree(	/*in*/ItemType items[],			//sorted list of elements 
-								/*inout*/OrdListClass& list,	//list to be created
-								/*in*/int start,				//starting index
-								/*in*/int end) const			//ending index
+//Pre: OrdListClass has been instantiated, map is safe to call from several threads at once, reduce is
+//		associative and commutative and identity is its identity value
+//Post: returns the reduction of map over every item of the list to the caller. identity if the list is empty
+MapType OrdListClass::ParallelMapReduce(/*in*/MapFunctionType map,			//value computed for each item
+										/*in*/ReduceFunctionType reduce,	//combines two values
+										/*in*/MapType identity) const		//value of an empty reduction
 {
+	MapType total = identity;
 
-	//slightly modified binary search. Instead of checking if the mp is our target, we add the array's mp value
-	//to the tree. this creates the most balanced complete tree possible given a sorted array (i think)
-	if (start <= end)
+	if (root != nullptr)
 	{
-		int mp = (start + end) / 2;
+		ThreadPoolClass* workPool = ReturnPool();
+		TaskGroup group;
+		mutex totalLock;
+		ReduceWorker proto = { map, reduce, identity, &total, &totalLock };
+		WaitGuard guard(workPool, group);
 
-		list.Find(items[mp].key);
-		list.Insert(items[mp]);
-		CreateTree(items, list, start, mp - 1);
-		CreateTree(items, list, mp + 1, end);
+		ParallelWalk(root, workPool, &group, &proto);
+		workPool->Wait(group);
 
 	}//end if
 
-}//end CreateTree
+	return total;
+
+}//end ParallelMapReduce
 
 
 /*****************************************************************************************************/
 
-//Pre: OrdListClass has been instantiated, visit is a valid FunctonType, trav is typically root (init)
-//Post: Traverses the list in order visiting each node. client defines what a "visit" is
-void OrdListClass::rInOrderTrav(/*inout*/FunctionType visit,	//function pointer (passes control to client)
-								/*in*/node* trav)				//current node
+//Pre: OrdListClass has been instantiated, map is safe to call from several threads at once. emit is safe
+//		to call from several threads at once unless ordered is true
+//Post: map has been applied to every item in parallel and each item and its result handed to emit. When
+//		ordered is true emit is called from the calling thread in key order, otherwise as results are ready
+void OrdListClass::ParallelMap(	/*in*/MapFunctionType map,		//value computed for each item
+								/*in*/EmitFunctionType emit,	//receives each item and its value
+								/*in*/bool ordered) const		//true to emit in key order
 {
-	if (trav != nullptr)
+	if (root == nullptr)
 	{
-		rInOrderTrav(visit, trav->left);
-		visit(trav->data);
-		rInOrderTrav(visit, trav->right);
+		return;
 
 	}//end if
 
-}//end InOrderTrav
+	ThreadPoolClass* workPool = ReturnPool();
+	TaskGroup group;
 
+	if (!ordered)
+	{
+		MapWorker proto = { map, emit };
+		WaitGuard guard(workPool, group);
 
-/*****************************************************************************************************/
+		ParallelWalk(root, workPool, &group, &proto);
+		workPool->Wait(group);
+		return;
 
-//Pre: OrdListClass has been instantiated, visit is a valid FunctonTypeFile, trav is typically root (init)
-//Post: Traverses the list in order visiting each node. client defines what a "visit" is
-void OrdListClass::rFileTrav(	/*inout*/FunctionTypeFile visit, //function pointer (passes control to client) 
-								/*in*/node* trav,				 //current node
-								/*inout*/ofstream& outdat)		 //out file stream
-{
-	//Prints each node in a pre-order fashion so that when the nodes are read back in to a class,
-	//An identical tree will have been created
+	}//end if
 
+	//Ordered: list the nodes in key order and cut the list into pieces of equal size (about 8 per worker), so a
+	//lopsided tree splits as evenly as a balanced one. every piece is mapped into its own part of results in
+	//parallel, then the results are emitted in key order
 
-	if (trav != nullptr)
+	vector<node*> nodes;
+	vector<MapType> results;
+
+	try
 	{
-		visit(trav->data, outdat);
-		rFileTrav(visit, trav->left, outdat);
-		rFileTrav(visit, trav->right, outdat);
-		
-	}//end if
+		nodes.reserve(length);
+		ListInOrder(root, &nodes);
+		results.resize(nodes.size());
 
-}//end rFileTrav
+	}//end try
 
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
 
-/*****************************************************************************************************/
+	}//end catch
 
-//Pre: OrdListClass has been instantiated, visit is a valid FunctonType, trav is typically root (init)
-//Post: Traverses the list backwards visiting each node. client defines what a "visit" is
-void OrdListClass::rBackwardInOrderTrav(/*inout*/FunctionType visit,	//function pointer (passes control to client)
-										/*in*/node* trav)				//current node
-{
-	//Visit in  a RNL fashion
+	size_t numPieces = min(nodes.size(), (size_t)(8 * workPool->ReturnSize()));
+	node** first = nodes.data();
+	MapType* out = results.data();
+	WaitGuard guard(workPool, group);
 
+	for (size_t i = 0; i < numPieces; ++i)
+	{
+		size_t start = nodes.size() * i / numPieces;
+		size_t end = nodes.size() * (i + 1) / numPieces;
 
-	if (trav != nullptr)
+		workPool->Spawn(group, [first, out, start, end, map]()
+		{
+			for (size_t j = start; j < end; ++j)
+			{
+				out[j] = map(first[j]->data);
+
+			}//end for
+		});
+
+	}//end for
+
+	workPool->Wait(group);
+
+	for (size_t i = 0; i < nodes.size(); ++i)
 	{
-		rBackwardInOrderTrav(visit, trav->right);
-		visit(trav->data);
-		rBackwardInOrderTrav(visit, trav->left);
+		emit(nodes[i]->data, results[i]);
 
-	}//end if
+	}//end for
 
-}//end rBackwardInOrderTrav
+}//end ParallelMap
 
 
 /*****************************************************************************************************/
 
-//Pre: OrdListClass has been instantiated. key is a valid KeyType
-//Post: returns true to the caller if key is found in the current object, false otherwise. wrapped function
-bool OrdListClass::rFind(/*in*/KeyType key) //key to find
-{
+//ranges smaller than this are built on the calling thread
+static const int PARALLEL_BUILD_CUTOFF = 16384;
 
-	if (currPos != nullptr)
-	{
 
-		if (currPos->data.key == key)
-		{
-			if (currPos == root)
-			{
-				prevPos = nullptr;
+//Pre: items[start..end] is a sorted range, block has room for every index of the range
+//Post: returns the root of a balanced tree over the range. the node for items[i] is block[i]. unsorted is
+//		set if some item does not have a greater key than the one before it
+static node* BuildRange(/*in*/ItemType items[],			//sorted items
+						/*inout*/node block[],			//node storage, one per item
+						/*in*/int start,				//starting index
+						/*in*/int end,					//ending index
+						/*in*/ThreadPoolClass* pool,	//pool to split large ranges on
+						/*inout*/atomic<bool>* unsorted)	//set on out of order keys
+{
+	//same midpoint split as CreateTree, but the links are written straight into the block
 
-			}//end if
+	if (start > end)
+	{
+		return nullptr;
 
-			return true;
+	}//end if
 
-		}//end if 
+	int mp = start + (end - start) / 2;
+	node* temp = &block[mp];
 
-		else if (currPos->data.key < key) //go right
-		{
-			prevPos = currPos;
-			currPos = currPos->right;
-			return rFind(key);
+	temp->data = items[mp];
+	temp->inBlock = true;
+	if (mp > 0 && !(items[mp - 1].key < items[mp].key))
+	{
+		*unsorted = true;
 
-		}//end else if
+	}//end if
 
-		else
-		{
-			prevPos = currPos;
-			currPos = currPos->left;
-			return rFind(key);
+	if (end - start > PARALLEL_BUILD_CUTOFF)
+	{
+		TaskGroup group;
+		WaitGuard guard(pool, group);
 
-		}//end else
+		pool->Spawn(group, [=]() { temp->left = BuildRange(items, block, start, mp - 1, pool, unsorted); });
+		temp->right = BuildRange(items, block, mp + 1, end, pool, unsorted);
+		pool->Wait(group);
 
 	}//end if
 
 	else
 	{
-		return false;
+		temp->left = BuildRange(items, block, start, mp - 1, pool, unsorted);
+		temp->right = BuildRange(items, block, mp + 1, end, pool, unsorted);
 
 	}//end else
 
-}//end rFind
+	return temp;
+
+}//end BuildRange
 
 
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, items holds length items sorted by strictly increasing key
+//		(non-decreasing in multiset mode). if adopt is true items was allocated with new[]
+//Post: the list holds exactly the length items of items, as a balanced tree. The nodes are carved from one
+//		contiguous block and the two halves of every range are built in parallel on the pool. A multiset makes
+//		one node of every run of equal keys, the first item of the run, counted once per item as InsertBatch
+//		counts. If adopt is true the list has taken ownership of items and released it, the caller must not use
+//		it again
+//Exceptions thrown: throws a DuplicateKeyException if items is not strictly increasing, or not non-decreasing
+//					 for a multiset (the list is left empty)
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+void OrdListClass::BuildFromSorted(	/*in*/ItemType items[],	//sorted items
+									/*in*/int length,		//number of items
+									/*in*/bool adopt)		//true to hand items over to the list
+{
+	//A node carries its item inline, so the caller's buffer can not become the node storage. Adopting it
+	//saves the caller from keeping (or copying) a second array alive: it is freed the moment the nodes are built
+
+	//size the index first, so that it can not run out of memory once the old nodes are gone
+	if (hashIndex != nullptr)
+	{
+		try
+		{
+			hashIndex->Reserve(length);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			if (adopt)
+			{
+				delete[] items;
+
+			}//end if
+
+			throw OutOfMemoryException();
+
+		}//end catch
+
+	}//end if
 
+	//a multiset counts repeats as InsertBatch does: a run of equal keys becomes one node, the first item of the
+	//run, and the length of the run becomes its count. the run is squeezed out of a copy unless items is ours
+	int* runs = nullptr;		//copies of every item left after the squeeze, parallel to items
+	if (multiset && length > 1 && adjacent_find(items, items + length,
+		[](const ItemType& left, const ItemType& right) { return left.key == right.key; }) != items + length)
+	{
+		try
+		{
+			if (!adopt)
+			{
+				ItemType* own = new ItemType[length];
+				copy(items, items + length, own);
+				items = own;
+				adopt = true;
+
+			}//end if
 
+			runs = new int[length];
 
+		}//end try
 
+		catch (bad_alloc&)
+		{
+			if (adopt)
+			{
+				delete[] items;
 
+			}//end if
 
+			throw OutOfMemoryException();
 
+		}//end catch
 
+		int unique = 0;
+		for (int i = 0; i < length; ++i)
+		{
+			if (unique > 0 && items[unique - 1].key == items[i].key)
+			{
+				++runs[unique - 1];
 
+			}//end if
 
+			else
+			{
+				items[unique] = items[i];
+				runs[unique] = 1;
+				++unique;
 
+			}//end else
 
+		}//end for
 
+		length = unique;
 
+	}//end if
 
+	Clear();
+
+	if (length <= 0)
+	{
+		if (adopt)
+		{
+			delete[] items;
+
+		}//end if
+
+		return;
+
+	}//end if
+
+	node* block = nullptr;
+	try
+	{
+		block = new node[length];
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		if (adopt)
+		{
+			delete[] items;
+
+		}//end if
+
+		delete[] runs;
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	atomic<bool> unsorted(false);
+	node* top = BuildRange(items, block, 0, length - 1, ReturnPool(), &unsorted);
+	++version;
+
+	if (adopt)
+	{
+		delete[] items;
+
+	}//end if
+
+	if (unsorted)
+	{
+		delete[] block;
+		delete[] runs;
+		throw DuplicateKeyException();
+
+	}//end if
+
+	//the list owns the block before the tree links to it. OwnBlock frees it if that runs out of memory
+
+	try
+	{
+		OwnBlock(block);
+
+	}//end try
+
+	catch (OutOfMemoryException&)
+	{
+		delete[] runs;
+		throw;
+
+	}//end catch
+
+	STAT_ADD(blockAllocations, 1);
+
+	//the node for items[i] is block[i], so the counts go straight in
+	for (int i = 0; runs != nullptr && i < length; ++i)
+	{
+		block[i].count = runs[i];
+
+	}//end for
+
+	delete[] runs;
+	root = top;
+	currPos = root;
+	prevPos = nullptr;
+	this->length = length;
+	maxLength = length;
+
+	if (hashIndex != nullptr)
+	{
+		IndexTree();
+
+	}//end if
+
+	if (filter != nullptr)
+	{
+		FilterTree(length);
+
+	}//end if
+
+}//end BuildFromSorted
+
+
+/*****************************************************************************************************/
+
+//ranges smaller than this are sorted or merged on the calling thread
+static const int PARALLEL_SORT_CUTOFF = 32768;
+
+
+//orders two items by key alone, so that equal keys keep their input order under a stable sort
+static bool KeyLess(/*in*/const ItemType& left, /*in*/const ItemType& right)
+{
+	return left.key < right.key;
+
+}//end KeyLess
+
+
+//Pre: first[0..firstLen) and second[0..secondLen) are sorted, out has room for both
+//Post: out holds both ranges merged, items of first before equal items of second. large merges are cut in two
+//		around the midpoint of the longer range and the halves merged in parallel
+static void ParallelMerge(	/*in*/ItemType* first,			//left run
+							/*in*/int firstLen,				//length of left run
+							/*in*/ItemType* second,			//right run
+							/*in*/int secondLen,			//length of right run
+							/*out*/ItemType* out,			//merged result
+							/*in*/ThreadPoolClass* pool)	//pool to split large merges on
+{
+	if (firstLen + secondLen <= PARALLEL_SORT_CUTOFF)
+	{
+		merge(first, first + firstLen, second, second + secondLen, out, KeyLess);
+		return;
+
+	}//end if
+
+	int firstCut; int secondCut;
+	if (firstLen >= secondLen)
+	{
+		firstCut = firstLen / 2;
+		secondCut = (int)(lower_bound(second, second + secondLen, first[firstCut], KeyLess) - second);
+
+	}//end if
+
+	else
+	{
+		secondCut = secondLen / 2;
+		firstCut = (int)(upper_bound(first, first + firstLen, second[secondCut], KeyLess) - first);
+
+	}//end else
+
+	TaskGroup group;
+	WaitGuard guard(pool, group);
+
+	pool->Spawn(group, [=]() { ParallelMerge(first, firstCut, second, secondCut, out, pool); });
+	ParallelMerge(first + firstCut, firstLen - firstCut, second + secondCut, secondLen - secondCut,
+				  out + firstCut + secondCut, pool);
+	pool->Wait(group);
+
+}//end ParallelMerge
+
+
+//Pre: items[start..end) is a range of items, temp has room for the same range
+//Post: items[start..end) is stably sorted by key. temp is scratch space
+static void ParallelSort(	/*inout*/ItemType* items,		//items to sort
+							/*inout*/ItemType* temp,		//scratch space of the same size
+							/*in*/int start,				//first index
+							/*in*/int end,					//one past the last index
+							/*in*/ThreadPoolClass* pool)	//pool to split large ranges on
+{
+	if (end - start <= PARALLEL_SORT_CUTOFF)
+	{
+		stable_sort(items + start, items + end, KeyLess);
+		return;
+
+	}//end if
+
+	int mp = start + (end - start) / 2;
+
+	TaskGroup group;
+	WaitGuard guard(pool, group);
+
+	pool->Spawn(group, [=]() { ParallelSort(items, temp, start, mp, pool); });
+	ParallelSort(items, temp, mp, end, pool);
+	pool->Wait(group);
+
+	ParallelMerge(items + start, mp - start, items + mp, end - mp, temp + start, pool);
+	copy(temp + start, temp + end, items + start);
+
+}//end ParallelSort
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, items holds length items in any order
+//Post: the list holds the items of items as a balanced tree. items is sorted by a parallel stable merge sort
+//		on the pool, then every run of equal keys is reduced to one item as policy says: KEEP_FIRST keeps the
+//		item that came first in items, KEEP_LAST the one that came last. A multiset counts every item of the
+//		run instead of dropping it (DUPLICATE_ERROR then keeps the first). items itself is not changed
+//Exceptions thrown: throws a DuplicateKeyException under DUPLICATE_ERROR if a key repeats outside multiset mode
+//					 (the list is not changed)
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+void OrdListClass::BulkLoad(/*in*/const ItemType items[],		//unsorted items
+							/*in*/int length,					//number of items
+							/*in*/DuplicatePolicyType policy)	//which of several equal keys survives
+{
+	ItemType* sorted = nullptr;
+	ItemType* temp = nullptr;
+
+	if (length < 0)
+	{
+		length = 0;
+
+	}//end if
+
+	try
+	{
+		sorted = new ItemType[length];
+		temp = new ItemType[length];
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		delete[] sorted;
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	copy(items, items + length, sorted);
+	ParallelSort(sorted, temp, 0, length, ReturnPool());
+	delete[] temp;
+
+	//squeeze every run of equal keys down to the item the policy keeps. a multiset keeps the whole run, with
+	//the kept item first, for BuildFromSorted to count
+	int unique = 0;
+	int first = 0;		//where the run of the last key starts
+	for (int i = 0; i < length; ++i)
+	{
+		if (unique > 0 && sorted[unique - 1].key == sorted[i].key)
+		{
+			if (policy == DUPLICATE_ERROR && !multiset)
+			{
+				delete[] sorted;
+				throw DuplicateKeyException();
+
+			}//end if
+
+			else if (policy == KEEP_LAST)
+			{
+				sorted[first] = sorted[i];
+
+			}//end else if
+
+			if (multiset)
+			{
+				sorted[unique] = sorted[i];
+				++unique;
+
+			}//end if
+
+		}//end if
+
+		else
+		{
+			first = unique;
+			sorted[unique] = sorted[i];
+			++unique;
+
+		}//end else
+
+	}//end for
+
+	BuildFromSorted(sorted, unique, true);
+
+}//end BulkLoad
+
+
+/*****************************************************************************************************/
+
+//Pre: path is the in order path of a walk (see NextInOrder)
+//Post: trav and its chain of left children have been pushed on path
+static void PushLeft(	/*in*/node* trav,				//root of the subtree to enter
+						/*inout*/vector<node*>& path)	//nodes still to visit
+{
+	while (trav != nullptr)
+	{
+		path.push_back(trav);
+		trav = trav->left;
+
+	}//end while
+
+}//end PushLeft
+
+
+/*****************************************************************************************************/
+
+//Pre: path is not empty, it was started with PushLeft(root, path)
+//Post: returns the next node in key order to the caller and steps path past it. the walk only reads links
+static node* NextInOrder(/*inout*/vector<node*>& path) //nodes still to visit
+{
+	node* temp = path.back();
+	path.pop_back();
+	PushLeft(temp->right, path);
+	return temp;
+
+}//end NextInOrder
+
+
+/*****************************************************************************************************/
+
+//a batch is merged and rebuilt instead of inserted key by key once batch * log2(list) passes this many
+//times (list + batch), i.e. once the descents would touch more nodes than walking and rebuilding the whole list
+static const int REBUILD_FACTOR = 2;
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, items holds length items in any order, status has room for length
+//		entries
+//Post: every key of items that was not already in the list has been inserted. status[i] is INSERTED if
+//		items[i] was added and DUPLICATE_KEY if its key was already in the list or appeared earlier in items
+//		(COUNTED in multiset mode, where every such item raises the count of its key).
+//		The batch is sorted once, then either inserted key by key (midpoint first, small batches) or merged
+//		with the whole list and rebuilt balanced (large batches), whichever touches fewer nodes.
+//		returns the number of items inserted to the caller
+//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap
+int OrdListClass::InsertBatch(	/*in*/const ItemType items[],			//items to insert
+								/*in*/int length,						//number of items
+								/*out*/InsertStatusType status[])		//outcome for each item
+{
+	if (length <= 0)
+	{
+		return 0;
+
+	}//end if
+
+	//sort indexes instead of items so that status can be reported in the caller's order. stable, so the
+	//first of several equal keys in the batch is the one that gets inserted
+
+	vector<int> order(length);
+	for (int i = 0; i < length; ++i)
+	{
+		order[i] = i;
+
+	}//end for
+
+	stable_sort(order.begin(), order.end(), [items](int left, int right) { return items[left].key < items[right].key; });
+
+	//a multiset keeps every copy: runs[u] is how many items share the key of the u-th unique one
+	vector<int> runs(multiset ? length : 0);
+	int unique = 0;
+	for (int i = 0; i < length; ++i)
+	{
+		if (unique > 0 && items[order[unique - 1]].key == items[order[i]].key)
+		{
+			status[order[i]] = multiset ? COUNTED : DUPLICATE_KEY;
+			if (multiset)
+			{
+				++runs[unique - 1];
+
+			}//end if
+
+		}//end if
+
+		else
+		{
+			order[unique] = order[i];
+			if (multiset)
+			{
+				runs[unique] = 1;
+
+			}//end if
+
+			++unique;
+
+		}//end else
+
+	}//end for
+
+	int inserted = 0;
+	double depth = log2((double)this->length + unique + 1.0);
+
+	if ((double)unique * depth < REBUILD_FACTOR * ((double)this->length + unique))
+	{
+		//incremental: drop keys that are already present, insert the rest midpoint first
+
+		int fresh = 0;
+		for (int i = 0; i < unique; ++i)
+		{
+			if (Find(items[order[i]].key))
+			{
+				status[order[i]] = multiset ? COUNTED : DUPLICATE_KEY;
+				if (multiset)
+				{
+					currPos->count += runs[i];
+
+				}//end if
+
+			}//end if
+
+			else
+			{
+				order[fresh] = order[i];
+				if (multiset)
+				{
+					runs[fresh] = runs[i];
+
+				}//end if
+
+				++fresh;
+
+			}//end else
+
+		}//end for
+
+		InsertMidpoints(items, order.data(), 0, fresh - 1, status);
+		inserted = fresh;
+
+		for (int i = 0; i < fresh && multiset; ++i)
+		{
+			if (runs[i] > 1)
+			{
+				Locate(items[order[i]].key);
+				currPos->count = runs[i];
+
+			}//end if
+
+		}//end for
+
+	}//end if
+
+	else
+	{
+		//merge and rebuild: walk the list in order and merge the batch in, then build a new balanced tree
+
+		//BuildFromSorted makes fresh nodes, so the counts and payload handles of the old ones are carried across
+		//in arrays parallel to merged
+
+		ItemType* merged = nullptr;
+		int* counts = nullptr;
+		PayloadHandle* handles = nullptr;
+		try
+		{
+			merged = new ItemType[this->length + unique];
+			if (multiset)
+			{
+				counts = new int[this->length + unique];
+
+			}//end if
+
+			if (payloads != nullptr)
+			{
+				handles = new PayloadHandle[this->length + unique];
+
+			}//end if
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			delete[] merged;
+			delete[] counts;
+			throw OutOfMemoryException();
+
+		}//end catch
+
+		int index = 0;
+		int next = 0;
+		vector<node*> path;
+		node* trav = root;
+
+		while (trav != nullptr || !path.empty())
+		{
+			while (trav != nullptr)
+			{
+				path.push_back(trav);
+				trav = trav->left;
+
+			}//end while
+
+			trav = path.back();
+			path.pop_back();
+
+			while (next < unique && items[order[next]].key < trav->data.key)
+			{
+				if (counts != nullptr) counts[index] = runs[next];
+				if (handles != nullptr) handles[index] = NO_PAYLOAD;
+				merged[index++] = items[order[next]];
+				status[order[next]] = INSERTED;
+				++next;
+
+			}//end while
+
+			if (counts != nullptr) counts[index] = trav->count;
+			if (handles != nullptr) handles[index] = trav->payload;
+
+			if (next < unique && items[order[next]].key == trav->data.key)
+			{
+				status[order[next]] = multiset ? COUNTED : DUPLICATE_KEY;
+				if (counts != nullptr) counts[index] += runs[next];
+				++next;
+
+			}//end if
+
+			merged[index++] = trav->data;
+			trav = trav->right;
+
+		}//end while
+
+		while (next < unique)
+		{
+			if (counts != nullptr) counts[index] = runs[next];
+			if (handles != nullptr) handles[index] = NO_PAYLOAD;
+			merged[index++] = items[order[next]];
+			status[order[next]] = INSERTED;
+			++next;
+
+		}//end while
+
+		inserted = index - this->length;
+
+		//the arena is held aside so that the Clear inside BuildFromSorted leaves the payloads alone
+		PayloadArenaClass* kept = payloads;
+		payloads = nullptr;
+
+		try
+		{
+			BuildFromSorted(merged, index, true);
+
+		}//end try
+
+		catch (...)
+		{
+			payloads = kept;
+			if (root == nullptr && payloads != nullptr)
+			{
+				payloads->Clear();		//the old nodes are gone, so are their payloads
+
+			}//end if
+
+			delete[] counts;
+			delete[] handles;
+			throw;
+
+		}//end catch
+
+		payloads = kept;
+
+		if (counts != nullptr || handles != nullptr)
+		{
+			int i = 0;
+
+			PushLeft(root, path);
+			while (!path.empty())
+			{
+				node* temp = NextInOrder(path);
+
+				if (counts != nullptr) temp->count = counts[i];
+				if (handles != nullptr) temp->payload = handles[i];
+				++i;
+
+			}//end while
+
+		}//end if
+
+		delete[] counts;
+		delete[] handles;
+
+	}//end else
+
+	return inserted;
+
+}//end InsertBatch
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns a snapshot of the operation counters and the shape of the tree to the caller. The shape
+//		(length, height, average depth, depth histogram) is measured by walking the tree, O(N). The counters
+//		are only kept when compiled with ORDLIST_STATS, otherwise they read 0 and countersEnabled is false
+ListStats OrdListClass::Stats() const
+{
+	ListStats snapshot;
+	long long depthSum = 0;
+	vector<pair<node*, int> > pending;
+
+	snapshot.counters = counters;
+#ifdef ORDLIST_STATS
+	snapshot.countersEnabled = true;
+#else
+	snapshot.countersEnabled = false;
+#endif
+	snapshot.length = 0;
+	snapshot.height = 0;
+	snapshot.indexBytes = ReturnIndexBytes();
+	snapshot.filterBytes = ReturnFilterBytes();
+	snapshot.payloadBytes = (payloads != nullptr) ? payloads->ReturnBytes() : 0;
+
+	//iterative walk so that a degenerate tree can be measured without overflowing the stack
+
+	if (root != nullptr)
+	{
+		pending.push_back(make_pair(root, 0));
+
+	}//end if
+
+	while (!pending.empty())
+	{
+		node* trav = pending.back().first;
+		int depth = pending.back().second;
+		pending.pop_back();
+
+		if ((int)snapshot.depthHistogram.size() <= depth)
+		{
+			snapshot.depthHistogram.resize(depth + 1, 0);
+
+		}//end if
+
+		snapshot.depthHistogram[depth]++;
+		snapshot.length++;
+		depthSum += depth;
+
+		if (trav->left != nullptr)
+		{
+			pending.push_back(make_pair(trav->left, depth + 1));
+
+		}//end if
+
+		if (trav->right != nullptr)
+		{
+			pending.push_back(make_pair(trav->right, depth + 1));
+
+		}//end if
+
+	}//end while
+
+	snapshot.height = (int)snapshot.depthHistogram.size();
+	snapshot.averageDepth = (snapshot.length > 0) ? (double)depthSum / snapshot.length : 0.0;
+
+	return snapshot;
+
+}//end Stats
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: every operation counter has been set back to zero
+void OrdListClass::ResetStats()
+{
+	OpCounters empty = { 0, 0, 0, 0, 0, 0 };
+	counters = empty;
+
+}//end ResetStats
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated. for BALANCE_SCAPEGOAT 0.5 < alpha < 1 (0.7 is a good default)
+//Post: sets how the list keeps its height in check. BALANCE_NONE is the plain BST. BALANCE_SCAPEGOAT checks
+//		the depth of every inserted node: past log(N) / log(1 / alpha) (about 1.94 * log2(N) for 0.7) the
+//		deepest ancestor whose child holds more than alpha of its nodes is rebuilt into a perfectly balanced
+//		subtree, the same midpoint split CreateTree uses, reusing the nodes in place. Once deletes shrink the
+//		list below alpha of its largest size since the last full rebuild, the whole tree is rebuilt. This gives
+//		amortized O(log N) updates with no extra data in the nodes. BALANCE_SPLAY makes Find splay the node it
+//		lands on (the key, or its neighbour on a miss) to the root and Insert add the new node as the root,
+//		so hot and freshly inserted keys are a few hops away, amortized O(log N). Retrieve and Delete after
+//		Find work as before, the cursor functions never splay. Switching modes does not reshape the tree
+void OrdListClass::SetBalanceMode(	/*in*/BalanceModeType mode,	//balancing strategy
+									/*in*/double alpha)			//scapegoat weight balance factor
+{
+	if (alpha <= 0.5 || alpha >= 1.0)
+	{
+		alpha = 0.7;
+
+	}//end if
+
+	balanceMode = mode;
+	this->alpha = alpha;
+	maxLength = length;
+
+}//end SetBalanceMode
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: the tree has been reshaped into a complete balanced tree (height floor(log2 N) + 1) using the
+//		Day-Stout-Warren algorithm: right rotations straighten the tree into a sorted vine, then rounds of left
+//		rotations fold the vine back into a tree. O(N) time, O(1) extra memory, no node is allocated or freed
+//		and no item is copied. currPos is left at the root
+void OrdListClass::Rebalance()
+{
+	node pseudoRoot;		//stands above root so that rotations at the top need no special case
+	int size = 0;
+
+	pseudoRoot.left = nullptr;
+	pseudoRoot.right = root;
+
+	//tree to vine: rotate every left child up until the tree is one right leaning chain in key order
+
+	node* tail = &pseudoRoot;
+	node* rest = root;
+	while (rest != nullptr)
+	{
+		if (rest->left == nullptr)
+		{
+			tail = rest;
+			rest = rest->right;
+			++size;
+
+		}//end if
+
+		else
+		{
+			node* temp = rest->left;
+			rest->left = temp->right;
+			temp->right = rest;
+			rest = temp;
+			tail->right = temp;
+
+		}//end else
+
+	}//end while
+
+	//vine to tree: first fold away the nodes that do not fit in a perfect tree (they become the bottom
+	//level), then halve the spine until it is a single node
+
+	int perfect = 1;
+	while (perfect * 2 <= size + 1)
+	{
+		perfect *= 2;
+
+	}//end while
+
+	Compress(&pseudoRoot, size + 1 - perfect);
+
+	for (int spine = perfect - 1; spine > 1; spine /= 2)
+	{
+		Compress(&pseudoRoot, spine / 2);
+
+	}//end for
+
+	root = pseudoRoot.right;
+	++version;
+	cursorPending = false;
+	currPos = root;
+	prevPos = nullptr;
+	maxLength = length;
+
+}//end Rebalance
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key is a valid KeyType
+//Post: same result and cursor as Find. The search starts from the path to the position the previous
+//		FingerFind (or Insert after it) left behind: it climbs only until key falls inside the key range of a
+//		subtree on that path, then descends from there. A sorted run of probes therefore costs about the
+//		distance between neighbouring keys, O(log d) amortized, instead of a full descent each. Any other change
+//		to the tree drops the path and the next FingerFind starts from the root. In splay mode it is Find
+bool OrdListClass::FingerFind(/*in*/KeyType key) //key to find
+{
+	TIME_OP(OP_FIND);
+
+	if (balanceMode == BALANCE_SPLAY)
+	{
+		return Find(key);
+
+	}//end if
+
+	cursorPending = false;
+
+	if (fingerVersion != version)
+	{
+		finger.clear();
+
+	}//end if
+
+	//climb: pop every node whose subtree can not hold key
+
+	while (!finger.empty())
+	{
+		const FingerEntry& top = finger.back();
+		if ((!top.hasLow || top.low < key) && (!top.hasHigh || key < top.high))
+		{
+			break;
+
+		}//end if
+
+		finger.pop_back();
+
+	}//end while
+
+	if (finger.empty() && root != nullptr)
+	{
+		FingerPush(root);
+
+	}//end if
+
+	//descend: ordinary search from the lowest subtree that holds key, keeping the path
+
+	bool found = false;
+	while (!finger.empty())
+	{
+		node* trav = finger.back().trav;
+		STAT_ADD(findComparisons, 1);
+
+		if (trav->data.key == key)
+		{
+			found = true;
+			break;
+
+		}//end if
+
+		node* next = (key < trav->data.key) ? trav->left : trav->right;
+		if (next == nullptr)
+		{
+			break;
+
+		}//end if
+
+		FingerPush(next);
+
+	}//end while
+
+	fingerVersion = version;
+
+	if (finger.empty())
+	{
+		currPos = nullptr;
+		prevPos = nullptr;
+
+	}//end if
+
+	else if (found)
+	{
+		currPos = finger.back().trav;
+		prevPos = (finger.size() > 1) ? finger[finger.size() - 2].trav : nullptr;
+
+	}//end else if
+
+	else
+	{
+		currPos = nullptr;
+		prevPos = finger.back().trav;
+
+	}//end else
+
+	return found;
+
+}//end FingerFind
+
+
+/*****************************************************************************************************/
+
+//searches advanced together in one lockstep group. enough to cover the memory latency with independent misses,
+//few enough that every group's state stays in registers and L1
+static const int BATCH_GROUP = 16;
+
+
+//Pre: keys holds count keys, lower has room for count entries, exact too unless it is null
+//Post: lower[i] is the node with the smallest key >= keys[i] (null if none), exact[i] the node holding keys[i]
+//		(null if none)
+static void BatchDescend(	/*in*/node* root,				//root of the tree
+							/*in*/const KeyType keys[],		//keys to look up
+							/*in*/int count,				//number of keys
+							/*out*/node* exact[],			//node holding each key, may be null
+							/*out*/node* lower[])			//lower bound node of each key
+{
+	for (int base = 0; base < count; base += BATCH_GROUP)
+	{
+		int group = min(BATCH_GROUP, count - base);
+		node* trav[BATCH_GROUP];
+		int active = group;
+
+		for (int j = 0; j < group; ++j)
+		{
+			trav[j] = root;
+			lower[base + j] = nullptr;
+			if (exact != nullptr)
+			{
+				exact[base + j] = nullptr;
+
+			}//end if
+
+		}//end for
+
+		//every round moves each unfinished search one level down and prefetches where it goes next, so the
+		//next round finds that node already on its way into the cache
+
+		while (active > 0)
+		{
+			active = 0;
+			for (int j = 0; j < group; ++j)
+			{
+				node* temp = trav[j];
+				if (temp == nullptr)
+				{
+					continue;
+
+				}//end if
+
+				KeyType key = keys[base + j];
+				if (key < temp->data.key)
+				{
+					lower[base + j] = temp;
+					temp = temp->left;
+
+				}//end if
+
+				else if (temp->data.key < key)
+				{
+					temp = temp->right;
+
+				}//end else if
+
+				else
+				{
+					lower[base + j] = temp;
+					if (exact != nullptr)
+					{
+						exact[base + j] = temp;
+
+					}//end if
+
+					temp = nullptr;
+
+				}//end else
+
+				trav[j] = temp;
+				if (temp != nullptr)
+				{
+					PREFETCH(temp);
+					++active;
+
+				}//end if
+
+			}//end for
+
+		}//end while
+
+	}//end for
+
+}//end BatchDescend
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, keys holds count keys, found has room for count entries
+//Post: found[i] is true if keys[i] is in the list, false otherwise. Groups of searches advance one level at
+//		a time in lockstep and prefetch the node each one visits next, so the cache misses of different keys
+//		overlap instead of queueing behind each other. the list (cursor included) is not changed
+void OrdListClass::FindBatch(	/*in*/const KeyType keys[],	//keys to look up
+								/*in*/int count,				//number of keys
+								/*out*/bool found[]) const		//result for each key
+{
+	node* exact[BATCH_GROUP];
+	node* lower[BATCH_GROUP];
+
+	//with the index on each key is one or two probes, cheaper than any descent
+	if (hashIndex != nullptr)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			found[i] = (hashIndex->Find(keys[i]) != nullptr);
+
+		}//end for
+
+		return;
+
+	}//end if
+
+	for (int base = 0; base < count; base += BATCH_GROUP)
+	{
+		int group = min(BATCH_GROUP, count - base);
+
+		BatchDescend(root, keys + base, group, exact, lower);
+		for (int j = 0; j < group; ++j)
+		{
+			found[base + j] = (exact[j] != nullptr);
+
+		}//end for
+
+	}//end for
+
+}//end FindBatch
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, keys holds count keys, bounds and hasBound have room for count entries
+//Post: bounds[i] is the item with the smallest key that is not less than keys[i] and hasBound[i] is true, or
+//		hasBound[i] is false if every key in the list is less than keys[i]. Searched in lockstep groups as in
+//		FindBatch. the list (cursor included) is not changed
+void OrdListClass::LowerBoundBatch(	/*in*/const KeyType keys[],		//keys to look up
+									/*in*/int count,				//number of keys
+									/*out*/ItemType bounds[],		//lower bound of each key
+									/*out*/bool hasBound[]) const	//false where there is no lower bound
+{
+	node* lower[BATCH_GROUP];
+
+	for (int base = 0; base < count; base += BATCH_GROUP)
+	{
+		int group = min(BATCH_GROUP, count - base);
+
+		BatchDescend(root, keys + base, group, nullptr, lower);
+		for (int j = 0; j < group; ++j)
+		{
+			hasBound[base + j] = (lower[j] != nullptr);
+			if (lower[j] != nullptr)
+			{
+				bounds[base + j] = lower[j]->data;
+
+			}//end if
+
+		}//end for
+
+	}//end for
+
+}//end LowerBoundBatch
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, 0 < loadFactor < 1 (0.5 is a good default)
+//Post: enabled builds a hash index from key to node next to the tree, !enabled drops it. The index fills at
+//		most loadFactor of its slots, so each key costs at least 16 / loadFactor bytes on a 64 bit build (32
+//		at 0.5), up to twice that right after the table doubles. While it is on, Find looks the key up in
+//		the index and leaves the tree alone (no splaying either), so Find followed by Retrieve never walks
+//		the tree. Ordered functions still use the tree. Insert and Delete after such a Find descend once to
+//		find the parent
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void OrdListClass::SetHashIndex(/*in*/bool enabled,			//true to keep an index
+								/*in*/double loadFactor)	//largest fraction of index slots in use
+{
+	SettleCursor();
+	delete hashIndex;
+	hashIndex = nullptr;
+
+	if (enabled)
+	{
+		try
+		{
+			hashIndex = new HashIndexClass(loadFactor);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			throw OutOfMemoryException();
+
+		}//end catch
+
+		IndexTree();
+
+	}//end if
+
+}//end SetHashIndex
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns the number of bytes held by the hash index, 0 when it is off
+long long OrdListClass::ReturnIndexBytes() const
+{
+	return (hashIndex != nullptr) ? hashIndex->ReturnBytes() : 0;
+
+}//end ReturnIndexBytes
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, 0 < falsePositiveRate < 1 (0.01 is a good default)
+//Post: enabled puts a cuckoo filter in front of Find, !enabled drops it. Find first asks the filter and
+//		returns false at once (no tree walk, no splaying) when the filter is sure the key is missing. Of the
+//		Finds for missing keys at most about falsePositiveRate still walk the tree. Fingerprints take 4 to 16
+//		bits (rate ~ 8 / 2^bits, so 0.01 gets 10 bits, 0.0002 gets 16), stored in 16 bit slots at most 90%
+//		full: 2.2 to 8 bytes per key. Insert and Delete keep the filter exact, BuildFromSorted (and so
+//		BulkLoad, InsertBatch and operator+) rebuilds it in one pass over the loaded tree. Insert and Delete
+//		after a rejected Find descend once to find the parent
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void OrdListClass::SetFilter(	/*in*/bool enabled,					//true to keep a filter
+								/*in*/double falsePositiveRate)		//largest share of misses that walk the tree
+{
+	SettleCursor();
+	delete filter;
+	filter = nullptr;
+
+	if (enabled)
+	{
+		try
+		{
+			filter = new CuckooFilterClass(falsePositiveRate);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			throw OutOfMemoryException();
+
+		}//end catch
+
+		FilterTree(length);
+
+	}//end if
+
+}//end SetFilter
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns the number of bytes held by the filter, 0 when it is off
+long long OrdListClass::ReturnFilterBytes() const
+{
+	return (filter != nullptr) ? filter->ReturnBytes() : 0;
+
+}//end ReturnFilterBytes
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, currPos is on an item (Find returned true, or Insert was just
+//		called), bytes holds size bytes
+//Post: the item at currPos carries a copy of bytes as its payload, replacing any payload it had. Payloads
+//		live in an arena beside the tree and a node only keeps a 4 byte handle to its payload, so Find and
+//		the other descents touch the same small nodes however large the payloads are. Copies of the list
+//		(copy constructor, operator=, operator+) copy the payloads, BuildFromSorted makes items without one
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void OrdListClass::SetPayload(	/*in*/const char* bytes,	//payload to copy
+								/*in*/int size)				//number of bytes
+{
+	try
+	{
+		if (payloads == nullptr)
+		{
+			payloads = new PayloadArenaClass;
+
+		}//end if
+
+		currPos->payload = payloads->Replace(currPos->payload, bytes, size);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end SetPayload
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, currPos is on an item
+//Post: returns a view of the payload of the item at currPos to the caller, { nullptr, 0 } if it has none.
+//		nothing is copied: the view stays valid until that item's payload is set again, the item is
+//		deleted, or the list is cleared or reloaded
+//Exceptions thrown: throws a RetrieveOnEmptyException if the list is empty
+PayloadView OrdListClass::RetrievePayload() const
+{
+	if (root == nullptr)
+	{
+		throw RetrieveOnEmptyException();
+
+	}//end if
+
+	if (payloads == nullptr)
+	{
+		PayloadView none = { nullptr, 0 };
+		return none;
+
+	}//end if
+
+	return payloads->View(currPos->payload);
+
+}//end RetrievePayload
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated. no Find is needed first
+//Post: if the key of newItem is not in the list, newItem has been inserted and INSERTED is returned.
+//		otherwise nothing changes and DUPLICATE_KEY is returned (a multiset raises its count and returns
+//		COUNTED). either way currPos is left on the item with that key, so Retrieve, RetrievePayload and
+//		SetPayload apply to it. The search for the key is also the search for the parent, so the tree is
+//		descended once (with the hash index on, a duplicate costs one probe). Balance modes, index and
+//		filter are kept up to date as by Insert
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+InsertStatusType OrdListClass::TryInsert(/*in*/ItemType newItem) //item to insert
+{
+	return Upsert(newItem, false);
+
+}//end TryInsert
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated. no Find is needed first
+//Post: if the key of newItem is not in the list, newItem has been inserted and INSERTED is returned.
+//		otherwise the item with that key has been overwritten by newItem (its payload is kept) and ASSIGNED
+//		is returned. currPos is left on the item, the tree is descended once, as in TryInsert
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+InsertStatusType OrdListClass::InsertOrAssign(/*in*/ItemType newItem) //item to insert or assign
+{
+	return Upsert(newItem, true);
+
+}//end InsertOrAssign
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is the root of a subtree (may be null)
+//Post: the subtree has been cut along the search path of key: less holds the keys less than key (or not greater
+//		than key if keyGoesLeft), rest every other key. both are valid BSTs made of the original nodes, O(H)
+static void SplitAt(/*in*/node* trav,		//root of the subtree to cut
+					/*in*/KeyType key,		//key to cut at
+					/*in*/bool keyGoesLeft,	//true to put key itself in less
+					/*out*/node*& less,		//root of the smaller keys
+					/*out*/node*& rest)		//root of the other keys
+{
+	//every node on the path goes to one side. its subtree on the far side of the cut goes with it, and the
+	//next node of the same side hangs where the path left it
+
+	node** lessTail = &less;
+	node** restTail = &rest;
+
+	while (trav != nullptr)
+	{
+		if (trav->data.key < key || (keyGoesLeft && trav->data.key == key))
+		{
+			*lessTail = trav;
+			lessTail = &trav->right;
+			trav = trav->right;
+
+		}//end if
+
+		else
+		{
+			*restTail = trav;
+			restTail = &trav->left;
+			trav = trav->left;
+
+		}//end else
+
+	}//end while
+
+	*lessTail = nullptr;
+	*restTail = nullptr;
+
+}//end SplitAt
+
+
+/*****************************************************************************************************/
+
+//Pre: every key of less is smaller than every key of greater, either may be null
+//Post: returns the root of one tree holding both. the largest node of less is lifted to the root, so the height
+//		is at most one more than the taller of the two. O(height of less)
+static node* JoinTrees(	/*in*/node* less,		//tree of the smaller keys
+						/*in*/node* greater)	//tree of the greater keys
+{
+	if (less == nullptr)
+	{
+		return greater;
+
+	}//end if
+
+	if (greater == nullptr)
+	{
+		return less;
+
+	}//end if
+
+	node** link = &less;
+	while ((*link)->right != nullptr)
+	{
+		link = &(*link)->right;
+
+	}//end while
+
+	node* top = *link;
+	*link = top->left;
+	top->left = less;
+	top->right = greater;
+	return top;
+
+}//end JoinTrees
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated. no Find is needed first
+//Post: if key is in the list its item (and payload) has been removed and true returned, false otherwise.
+//		One descent: a node with two children is replaced by relinking its successor in its place, rather
+//		than copying the successor's item and searching for it again as Delete does. With the filter on, a
+//		key the filter rules out returns at once. currPos is left on the root
+bool OrdListClass::Erase(/*in*/KeyType key) //key to remove
+{
+	TIME_OP(OP_DELETE);
+
+	if (filter != nullptr && !filter->MayContain(key))
+	{
+		STAT_ADD(filterRejects, 1);
+		return false;
+
+	}//end if
+
+	//link is the pointer that holds the node being looked at, so unlinking it needs no parent
+
+	node** link = &root;
+	while (*link != nullptr && (*link)->data.key != key)
+	{
+		STAT_ADD(findComparisons, 1);
+		link = (key < (*link)->data.key) ? &(*link)->left : &(*link)->right;
+
+	}//end while
+
+	if (*link == nullptr)
+	{
+		return false;
+
+	}//end if
+
+	node* trav = *link;
+
+	if (trav->left == nullptr)
+	{
+		*link = trav->right;
+
+	}//end if
+
+	else if (trav->right == nullptr)
+	{
+		*link = trav->left;
+
+	}//end else if
+
+	else
+	{
+		node** nextLink = &trav->right;
+		while ((*nextLink)->left != nullptr)
+		{
+			nextLink = &(*nextLink)->left;
+
+		}//end while
+
+		node* next = *nextLink;
+		*nextLink = next->right;
+		next->left = trav->left;
+		next->right = trav->right;
+		*link = next;
+
+	}//end else
+
+	ReleaseNode(trav);
+	++version;
+	cursorPending = false;
+	currPos = root;
+	prevPos = nullptr;
+
+	if (balanceMode == BALANCE_SCAPEGOAT && length < alpha * maxLength)
+	{
+		Rebalance();
+
+	}//end if
+
+	return true;
+
+}//end Erase
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: every item with low <= key <= high has been removed and their number returned (0 if low > high).
+//		The tree is cut at low and at high by relinking the two search paths, so the range comes out as one
+//		subtree that is freed in a single walk without allocating, and what is left either side is joined
+//		back under one node. The cut is O(H + k) for k removed items. When anything was removed the tree
+//		is then rebalanced once (O(N), no allocation) in every mode, so a large range leaves a complete
+//		tree behind rather than the joined pieces. currPos is left on the root
+int OrdListClass::EraseRange(	/*in*/KeyType low,		//smallest key to remove
+								/*in*/KeyType high)		//largest key to remove
+{
+	TIME_OP(OP_DELETE);
+	node* below = nullptr;
+	node* middle = nullptr;
+	node* inRange = nullptr;
+	node* above = nullptr;
+
+	if (high < low)
+	{
+		return 0;
+
+	}//end if
+
+	SplitAt(root, low, false, below, middle);
+	SplitAt(middle, high, true, inRange, above);
+	root = JoinTrees(below, above);
+
+	int removed = ReleaseTree(inRange);
+	++version;
+	cursorPending = false;
+	currPos = root;
+	prevPos = nullptr;
+
+	if (removed > 0)
+	{
+		Rebalance();
+
+	}//end if
+
+	return removed;
+
+}//end EraseRange
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is not null
+//Post: returns the node with the largest key under trav if rightmost, the smallest otherwise
+static node* Extreme(	/*in*/node* trav,		//root of the subtree
+						/*in*/bool rightmost)	//true for the largest key
+{
+	node* next = rightmost ? trav->right : trav->left;
+
+	while (next != nullptr)
+	{
+		trav = next;
+		next = rightmost ? trav->right : trav->left;
+
+	}//end while
+
+	return trav;
+
+}//end Extreme
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is the root of a tree of total nodes
+//Post: returns the number of nodes with keys >= key to the caller. the nodes on either side of key are walked
+//		a node at a time in turn and the walk stops when the smaller side runs out, so it costs O(H) plus twice
+//		the size of the smaller side. reads only
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+static int CountPiece(	/*in*/node* trav,		//root of the tree
+						/*in*/KeyType key,		//smallest key of the side counted
+						/*in*/int total)		//nodes in the tree
+{
+	//a node on the wrong side of key is on the search path of key, only its child towards key is walked
+
+	vector<node*> pending[2];			//side 0 walks the keys >= key, side 1 the smaller ones
+	int counted[2] = { 0, 0 };
+
+	if (trav != nullptr)
+	{
+		pending[0].push_back(trav);
+		pending[1].push_back(trav);
+
+	}//end if
+
+	while (!pending[0].empty() && !pending[1].empty())
+	{
+		for (int side = 0; side < 2; ++side)
+		{
+			node* temp = pending[side].back();
+			bool above = !(temp->data.key < key);
+			pending[side].pop_back();
+
+			if (above == (side == 0))
+			{
+				++counted[side];
+
+			}//end if
+
+			if (temp->left != nullptr && (above || side == 1))
+			{
+				pending[side].push_back(temp->left);
+
+			}//end if
+
+			if (temp->right != nullptr && (!above || side == 0))
+			{
+				pending[side].push_back(temp->right);
+
+			}//end if
+
+		}//end for
+
+	}//end while
+
+	return pending[0].empty() ? counted[0] : total - counted[1];
+
+}//end CountPiece
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, greater is a different list
+//Post: greater holds the items with keys >= key (whatever it held before is cleared) and the current list
+//		the items with smaller keys. The tree is cut along the search path of key, so no node is copied or
+//		allocated and both pieces are no taller than the tree was. Nodes carry no subtree sizes, so this is not
+//		O(log N): the lengths are found by counting the smaller piece, O(H + min(k, N - k)) for k moved items.
+//		When either list keeps a hash index, a filter or payloads, the entries of the k moved items move too,
+//		O(H + k). Each list keeps its own balance mode. in scapegoat mode a piece keeps the size epoch of the
+//		tree and, like a Delete, is rebuilt in O(piece) once it holds less than alpha of that size (always if
+//		the tree was not bounded by the same alpha). both cursors are left on the roots
+//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap. every
+//					 allocation comes before the tree is cut, so the current list is not changed (greater may
+//					 have been cleared). only when the filter of greater has to be rebuilt after the move and
+//					 runs out of memory is the split complete, and greater left without a filter
+void OrdListClass::Split(	/*in*/KeyType key,				//smallest key to move
+							/*inout*/OrdListClass& greater)	//receives the items with keys >= key
+{
+	node* less = nullptr;
+	node* rest = nullptr;
+	vector<node*> moved;
+	vector<PayloadHandle> copies;
+	int movedCount;
+	int oldMax = max(maxLength, length);		//size the height of both pieces is bounded by
+	bool bounded = (balanceMode == BALANCE_SCAPEGOAT);
+	vector<shared_ptr<node> > shared;			//greater's share of the blocks some of its nodes may be carved from
+
+	try
+	{
+		shared = nodeBlocks;
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	greater.Clear();
+
+	if (HasSideData() || greater.HasSideData())
+	{
+		CopyOut(root, key, false, greater, moved, copies);
+		movedCount = (int)moved.size();
+
+	}//end if
+
+	else
+	{
+		try
+		{
+			movedCount = CountPiece(root, key, length);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			throw OutOfMemoryException();
+
+		}//end catch
+
+	}//end else
+
+	//nothing below allocates until the filter of greater takes the moved keys
+
+	greater.nodeBlocks.swap(shared);
+	SplitAt(root, key, false, less, rest);
+	root = less;
+	MoveOut(moved, copies);
+
+	greater.root = rest;
+	greater.length = movedCount;
+	length -= movedCount;
+	greater.MoveIn(moved);
+
+	++version;
+	cursorPending = false;
+	currPos = root;
+	prevPos = nullptr;
+
+	++greater.version;
+	greater.cursorPending = false;
+	greater.currPos = greater.root;
+	greater.prevPos = nullptr;
+
+	//scapegoat: a piece is no taller than the tree was, so the height bound of the old size still holds and the
+	//piece keeps that size. like a Delete, a piece that kept less than alpha of it is rebuilt. a piece that
+	//comes from a tree without that bound (or a different alpha) is rebuilt whatever its size
+
+	maxLength = bounded ? oldMax : length;
+	if (bounded && length < alpha * maxLength)
+	{
+		Rebalance();
+
+	}//end if
+
+	greater.maxLength = greater.length;
+	if (greater.balanceMode == BALANCE_SCAPEGOAT)
+	{
+		if (bounded && greater.alpha == alpha)
+		{
+			greater.maxLength = oldMax;
+
+		}//end if
+
+		if (greater.length < greater.alpha * greater.maxLength || !bounded || greater.alpha != alpha)
+		{
+			greater.Rebalance();
+
+		}//end if
+
+	}//end if
+
+}//end Split
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, other is a different list, every key of other is greater than
+//		every key of the current list, or every key of other is smaller
+//Post: every item of other has been moved into the current list and other is empty. The largest node of the
+//		lower tree is lifted to become the root over both trees, so no node is copied or allocated and the
+//		tree is at most one level taller than the taller of the two. O(H), plus O(size of other) when
+//		either list keeps a hash index, a filter or payloads. the cursors are left on the roots
+//Exceptions thrown: throws a KeyRangeOverlapException if the key ranges overlap. neither list is changed
+//					 throws an OutOfMemoryException when there is no more space left on the heap. neither list
+//					 is changed, unless the filter of the current list has to be rebuilt after the move and
+//					 runs out of memory: then the join is complete and the list left without a filter
+void OrdListClass::Join(/*inout*/OrdListClass& other) //list to move in
+{
+	vector<node*> moved;
+	vector<PayloadHandle> copies;
+	bool otherAbove = true;		//true if every key of other is greater than every key here
+
+	if (&other == this || other.root == nullptr)
+	{
+		return;
+
+	}//end if
+
+	if (root != nullptr)
+	{
+		if (Extreme(root, true)->data.key < Extreme(other.root, false)->data.key)
+		{
+			otherAbove = true;
+
+		}//end if
+
+		else if (Extreme(other.root, true)->data.key < Extreme(root, false)->data.key)
+		{
+			otherAbove = false;
+
+		}//end else if
+
+		else
+		{
+			throw KeyRangeOverlapException();
+
+		}//end else
+
+	}//end if
+
+	//the blocks other's nodes may be carved from come along, room for them is made first
+	try
+	{
+		nodeBlocks.reserve(nodeBlocks.size() + other.nodeBlocks.size());
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	if (HasSideData() || other.HasSideData())
+	{
+		other.CopyOut(other.root, KeyType(), true, *this, moved, copies);
+
+	}//end if
+
+	other.MoveOut(moved, copies);
+	root = otherAbove ? JoinTrees(root, other.root) : JoinTrees(other.root, root);
+	length += other.length;
+	nodeBlocks.insert(nodeBlocks.end(), other.nodeBlocks.begin(), other.nodeBlocks.end());
+	other.nodeBlocks.clear();
+
+	other.root = nullptr;
+	other.length = 0;
+	other.maxLength = 0;
+	++other.version;
+	other.cursorPending = false;
+	other.currPos = nullptr;
+	other.prevPos = nullptr;
+
+	MoveIn(moved);
+	++version;
+	cursorPending = false;
+	currPos = root;
+	prevPos = nullptr;
+	if (length > maxLength)
+	{
+		maxLength = length;
+
+	}//end if
+
+}//end Join
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: returns the node nearest key on the side asked for (below or above, key itself included if inclusive)
+//		to the caller, nullptr if there is none. reads only
+static node* Nearest(	/*in*/node* trav,		//root of the tree
+						/*in*/KeyType key,		//key to look around
+						/*in*/bool below,		//true for the nearest smaller key, false for the nearest greater
+						/*in*/bool inclusive)	//true if key itself counts
+{
+	//every node that lies on the wanted side is a better answer than the last one, since the path closes in
+
+	node* best = nullptr;
+
+	while (trav != nullptr)
+	{
+		if (trav->data.key == key && inclusive)
+		{
+			return trav;
+
+		}//end if
+
+		bool onSide = below ? (trav->data.key < key) : (key < trav->data.key);
+		if (onSide)
+		{
+			best = trav;
+
+		}//end if
+
+		//below: a candidate sends the search right to look for a closer one, anything else sends it left
+		trav = (onSide == below) ? trav->right : trav->left;
+
+	}//end while
+
+	return best;
+
+}//end Nearest
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key need not be in the list
+//Post: returns true to the caller and sets item to the item with the largest key <= key, false if every key
+//		is greater. One descent that only reads the tree: the cursor is not moved and the tree is not
+//		splayed, so any number of threads may query a list nobody is changing
+bool OrdListClass::Floor(	/*in*/KeyType key,					//key to look around
+							/*out*/ItemType& item) const		//item found
+{
+	node* temp = Nearest(root, key, true, true);
+
+	if (temp != nullptr)
+	{
+		item = temp->data;
+
+	}//end if
+
+	return (temp != nullptr);
+
+}//end Floor
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key need not be in the list
+//Post: returns true to the caller and sets item to the item with the smallest key >= key, false if every
+//		key is smaller. reads only, as Floor
+bool OrdListClass::Ceiling(	/*in*/KeyType key,				//key to look around
+							/*out*/ItemType& item) const	//item found
+{
+	node* temp = Nearest(root, key, false, true);
+
+	if (temp != nullptr)
+	{
+		item = temp->data;
+
+	}//end if
+
+	return (temp != nullptr);
+
+}//end Ceiling
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key need not be in the list
+//Post: returns true to the caller and sets item to the item with the largest key < key, false if there is
+//		none. reads only, as Floor
+bool OrdListClass::Predecessor(	/*in*/KeyType key,				//key to look around
+								/*out*/ItemType& item) const	//item found
+{
+	node* temp = Nearest(root, key, true, false);
+
+	if (temp != nullptr)
+	{
+		item = temp->data;
+
+	}//end if
+
+	return (temp != nullptr);
+
+}//end Predecessor
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key need not be in the list
+//Post: returns true to the caller and sets item to the item with the smallest key > key, false if there is
+//		none. reads only, as Floor
+bool OrdListClass::Successor(	/*in*/KeyType key,				//key to look around
+								/*out*/ItemType& item) const	//item found
+{
+	node* temp = Nearest(root, key, false, false);
+
+	if (temp != nullptr)
+	{
+		item = temp->data;
+
+	}//end if
+
+	return (temp != nullptr);
+
+}//end Successor
+
+
+/*****************************************************************************************************/
+
+//Pre: nodes[start..end] are the nodes of a subtree in key order
+//Post: returns the root of a balanced subtree linking those nodes, midpoint first as in CreateTree
+static node* LinkMidpoints(	/*in*/vector<node*>& nodes,	//nodes in key order
+							/*in*/int start,				//starting index
+							/*in*/int end)					//ending index
+{
+	if (start > end)
+	{
+		return nullptr;
+
+	}//end if
+
+	int mp = start + (end - start) / 2;
+	node* temp = nodes[mp];
+
+	temp->left = LinkMidpoints(nodes, start, mp - 1);
+	temp->right = LinkMidpoints(nodes, mp + 1, end);
+	return temp;
+
+}//end LinkMidpoints
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, rightOp is a valid OrdListClass
+//Post: the current list holds the union of its keys and rightOp's keys. where both have a key the current
+//		item (and payload) is kept as in operator+, and a multiset adds up the counts. A small rightOp
+//		(m * log2(N) < N) is inserted key by key, so the tree keeps its shape and balance mode. Otherwise
+//		both trees are merged in one in order pass and the current nodes plus one new node per new key are
+//		relinked into a balanced tree: no item array and no second tree, the extra memory is one pointer per
+//		node. rightOp is not changed and the cursor is left on the root
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. after a merge the
+//		list is then unchanged
+void OrdListClass::operator+=(/*in*/const OrdListClass& rightOp) //object to union into the current list
+{
+	TIME_OP(OP_UNION);
+
+	vector<node*> theirs;		//walk through rightOp
+	int total = length + rightOp.length;
+	int levels = 0;				//log2 of the largest possible result
+
+	if (&rightOp == this || rightOp.root == nullptr)
+	{
+		return;
+
+	}//end if
+
+	for (int count = total; count > 0; count >>= 1)
+	{
+		++levels;
+
+	}//end for
+
+	PushLeft(rightOp.root, theirs);
+
+	if ((long long)rightOp.length * levels < total)
+	{
+		//a descent per key is cheaper than touching every node
+
+		while (!theirs.empty())
+		{
+			node* from = NextInOrder(theirs);
+			InsertStatusType status = Upsert(from->data, false);
+
+			if (status == COUNTED)
+			{
+				currPos->count += from->count - 1;		//Upsert counted one copy
+
+			}//end if
+
+			else if (status == INSERTED)
+			{
+				currPos->count = multiset ? from->count : 1;
+				if (from->payload != NO_PAYLOAD)
+				{
+					PayloadView bytes = rightOp.payloads->View(from->payload);
+					SetPayload(bytes.data, bytes.size);
+
+				}//end if
+
+			}//end else if
+
+		}//end while
+
+	}//end if
+
+	else
+	{
+		vector<node*> mine;			//walk through the current tree
+		vector<node*> merged;		//every node of the result in key order
+		vector<node*> added;		//the nodes made for rightOp's new keys
+
+		//the current links are only read until every allocation has succeeded, so a failure undoes cleanly
+
+		try
+		{
+			merged.reserve(total);
+			added.reserve(rightOp.length);
+			if (hashIndex != nullptr)
+			{
+				hashIndex->Reserve(total);
+
+			}//end if
+
+			PushLeft(root, mine);
+			while (!mine.empty() || !theirs.empty())
+			{
+				if (theirs.empty() || (!mine.empty() && mine.back()->data.key <= theirs.back()->data.key))
+				{
+					node* temp = NextInOrder(mine);
+
+					if (!theirs.empty() && theirs.back()->data.key == temp->data.key)
+					{
+						NextInOrder(theirs);
+
+					}//end if
+
+					merged.push_back(temp);
+
+				}//end if
+
+				else
+				{
+					node* from = NextInOrder(theirs);
+					node* temp = Allocate();
+
+					added.push_back(temp);
+					merged.push_back(temp);
+					temp->data = from->data;
+					temp->count = multiset ? 0 : 1;		//a multiset adds up the counts below
+
+					if (from->payload != NO_PAYLOAD)
+					{
+						PayloadView bytes = rightOp.payloads->View(from->payload);
+
+						if (payloads == nullptr)
+						{
+							payloads = new PayloadArenaClass;
+
+						}//end if
+
+						temp->payload = payloads->Store(bytes.data, bytes.size);
+
+					}//end if
+
+				}//end else
+
+			}//end while
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			for (size_t i = 0; i < added.size(); ++i)
+			{
+				if (payloads != nullptr)
+				{
+					payloads->Release(added[i]->payload);
+
+				}//end if
+
+				Deallocate(added[i]);
+
+			}//end for
+
+			throw OutOfMemoryException();
+
+		}//end catch
+
+		//every key of rightOp is in merged now, so one more joint walk adds its counts without undo worries.
+		//the stack only ever holds as many nodes as the first walk did, so it does not grow
+		if (multiset)
+		{
+			size_t next = 0;
+
+			PushLeft(rightOp.root, theirs);
+			while (!theirs.empty())
+			{
+				node* from = NextInOrder(theirs);
+
+				while (merged[next]->data.key < from->data.key)
+				{
+					++next;
+
+				}//end while
+
+				merged[next]->count += from->count;
+
+			}//end while
+
+		}//end if
+
+		root = LinkMidpoints(merged, 0, (int)merged.size() - 1);
+		length = (int)merged.size();
+		maxLength = length;
+		++version;
+
+		for (size_t i = 0; i < added.size(); ++i)
+		{
+			IndexNode(added[i]);
+			FilterKey(added[i]->data.key);
+
+		}//end for
+
+	}//end else
+
+	cursorPending = false;
+	currPos = root;
+	prevPos = nullptr;
+
+}//end operator+=
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: enabled turns multiset mode on: Insert, TryInsert and InsertBatch of a key that is already in the
+//		list raise the count kept in its node instead of rejecting it, so a repeat allocates nothing, and
+//		Delete drops one copy at a time. Erase and EraseRange remove every copy, operator+ and operator+=
+//		add the counts of keys both lists hold, BulkLoad and BuildFromSorted make one node of every run of
+//		equal keys, counted once per item. expand makes NextPosition visit every copy of a key. Turning the
+//		mode off sets every count back to 1
+void OrdListClass::SetMultiset(	/*in*/bool enabled,		//true for a multiset
+								/*in*/bool expand)		//true to iterate over every copy
+{
+	//a Morris walk threads each node's predecessor back to it for the way up, so the counts are reset
+	//without a stack and every link is restored by the time the walk is done
+	node* trav = (multiset && !enabled) ? root : nullptr;
+
+	while (trav != nullptr)
+	{
+		node* temp = trav->left;
+
+		if (temp == nullptr)
+		{
+			trav->count = 1;
+			trav = trav->right;
+			continue;
+
+		}//end if
+
+		while (temp->right != nullptr && temp->right != trav)
+		{
+			temp = temp->right;
+
+		}//end while
+
+		if (temp->right == nullptr)
+		{
+			temp->right = trav;
+			trav = trav->left;
+
+		}//end if
+
+		else
+		{
+			temp->right = nullptr;
+			trav->count = 1;
+			trav = trav->right;
+
+		}//end else
+
+	}//end while
+
+	multiset = enabled;
+	expandCopies = enabled && expand;
+	copyOf = nullptr;
+
+}//end SetMultiset
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns the number of copies of key in the list to the caller, 0 if it is not there (always 0 or 1
+//		outside multiset mode). reads only, as Floor
+int OrdListClass::Count(/*in*/KeyType key) const //key to count
+{
+	node* trav = root;
+
+	if (filter != nullptr && !filter->MayContain(key))
+	{
+		return 0;
+
+	}//end if
+
+	if (hashIndex != nullptr)
+	{
+		trav = hashIndex->Find(key);
+		return (trav != nullptr) ? trav->count : 0;
+
+	}//end if
+
+	while (trav != nullptr && trav->data.key != key)
+	{
+		trav = (key < trav->data.key) ? trav->left : trav->right;
+
+	}//end while
+
+	return (trav != nullptr) ? trav->count : 0;
+
+}//end Count
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, currPos is on an item
+//Post: returns the number of copies of the item at currPos to the caller
+//Exceptions thrown: throws a RetrieveOnEmptyException if the list is empty
+int OrdListClass::RetrieveCount() const
+{
+	if (root == nullptr)
+	{
+		throw RetrieveOnEmptyException();
+
+	}//end if
+
+	return currPos->count;
+
+}//end RetrieveCount
+
+
+/*****************************************************************************************************/
+
+//bytes DumpFile gathers before every write, and the smallest slice of a file LoadFile parses on its own
+static const int FILE_BUFFER = 1 << 20;
+
+//longest key to_chars can make, with its sign and the newline after it
+static const int MAX_KEY_CHARS = numeric_limits<KeyType>::digits10 + 3;
+
+
+//Pre: OrdListClass has been instantiated
+//Post: the keys have been written to fileName one per line in preorder, so that LoadFile (or reading it back
+//		with Insert) makes an identical tree. The same file PrintFile makes with a client that writes
+//		key << endl, but the keys are formatted with to_chars into one large buffer that is written whole
+//		when full, and the stream is never flushed per key. counts and payloads are not written
+//Exceptions thrown: throws a FileException if fileName can not be opened or written
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+void OrdListClass::DumpFile(/*in*/string fileName) const //file to write
+{
+	ofstream outdat(fileName, ios::binary);
+
+	if (!outdat)
+	{
+		throw FileException();
+
+	}//end if
+
+	try
+	{
+		//the same preorder as rFileTrav, with a stack instead of recursion so a chain can not overflow it
+
+		vector<char> buffer(min((size_t)FILE_BUFFER, (size_t)length * MAX_KEY_CHARS + MAX_KEY_CHARS));
+		vector<node*> path;
+		size_t used = 0;
+
+		if (root != nullptr)
+		{
+			path.push_back(root);
+
+		}//end if
+
+		while (!path.empty())
+		{
+			node* trav = path.back();
+			path.pop_back();
+
+			if (used + MAX_KEY_CHARS > buffer.size())
+			{
+				outdat.write(buffer.data(), used);
+				used = 0;
+
+			}//end if
+
+			used = to_chars(buffer.data() + used, buffer.data() + buffer.size(), trav->data.key).ptr - buffer.data();
+			buffer[used++] = '\n';
+
+			if (trav->right != nullptr)
+			{
+				path.push_back(trav->right);
+
+			}//end if
+
+			if (trav->left != nullptr)
+			{
+				path.push_back(trav->left);
+
+			}//end if
+
+		}//end while
+
+		outdat.write(buffer.data(), used);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	outdat.close();
+	if (!outdat)
+	{
+		throw FileException();
+
+	}//end if
+
+}//end DumpFile
+
+
+/*****************************************************************************************************/
+
+//Pre: first and last bound a slice of text that starts and ends between keys
+//Post: keys holds every whitespace separated key of the slice, in order. returns false to the caller if the
+//		slice holds something that is not a key
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+static bool ParseKeys(	/*in*/const char* first,			//start of the slice
+						/*in*/const char* last,				//end of the slice
+						/*out*/vector<ItemType>& keys)		//keys found
+{
+	ItemType temp;
+
+	while (first != last)
+	{
+		if (isspace((unsigned char)*first))
+		{
+			++first;
+
+		}//end if
+
+		else
+		{
+			from_chars_result result = from_chars(first, last, temp.key);
+
+			if (result.ec != errc())
+			{
+				return false;
+
+			}//end if
+
+			keys.push_back(temp);
+			first = result.ptr;
+
+		}//end else
+
+	}//end while
+
+	return true;
+
+}//end ParseKeys
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, fileName holds whitespace separated keys
+//Post: the list holds the keys of fileName. The file is read whole, cut into slices at whitespace and the
+//		slices parsed with from_chars in parallel on the pool. If the keys are a preorder (the output of
+//		PrintFile or DumpFile) the tree they describe is rebuilt in one O(N) pass into a contiguous block of
+//		nodes, the same tree reading the file back with Insert makes. Any other order of keys, and a preorder
+//		whose tree is more than 2 * log2(N) + 2 deep (a sorted file is the preorder of a chain), is loaded as
+//		a balanced tree by BulkLoad
+//Exceptions thrown: throws a FileException if fileName can not be read or holds something that is not a key
+//					 throws a DuplicateKeyException if a key repeats
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+//					 the list is not changed when an exception is thrown
+void OrdListClass::LoadFile(/*in*/string fileName) //file to read
+{
+	ifstream indat;
+	vector<char> text;
+	vector<vector<ItemType> > slices;
+	node* block = nullptr;
+	int count = 0;
+	OrdListClass loaded;		//the tree is built here and swapped in once nothing can fail
+
+	try
+	{
+		indat.open(fileName, ios::binary | ios::ate);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	if (!indat)
+	{
+		throw FileException();
+
+	}//end if
+
+	PrepareLoad(loaded);
+
+	try
+	{
+		text.resize((size_t)indat.tellg());
+		indat.seekg(0);
+		if (!indat.read(text.data(), text.size()))
+		{
+			throw FileException();
+
+		}//end if
+
+		//at least FILE_BUFFER bytes a slice, and a few slices per thread so a slow one does not hold the rest up
+
+		ThreadPoolClass* pool = ReturnPool();
+		size_t numSlices = min(text.size() / FILE_BUFFER + 1, (size_t)(4 * pool->ReturnSize() + 1));
+		vector<size_t> cut(numSlices + 1, text.size());
+		vector<char> parsed(numSlices, false);
+		TaskGroup group;
+		WaitGuard guard(pool, group);
+
+		cut[0] = 0;
+		for (size_t i = 1; i < numSlices; ++i)
+		{
+			cut[i] = max(cut[i - 1], text.size() * i / numSlices);
+			while (cut[i] < text.size() && !isspace((unsigned char)text[cut[i] - 1]))
+			{
+				++cut[i];
+
+			}//end while
+
+		}//end for
+
+		slices.resize(numSlices);
+		for (size_t i = 0; i < numSlices; ++i)
+		{
+			const char* first = text.data() + cut[i];
+			const char* last = text.data() + cut[i + 1];
+			vector<ItemType>* keys = &slices[i];
+			char* done = &parsed[i];
+
+			if (i + 1 < numSlices)
+			{
+				pool->Spawn(group, [=]() { *done = ParseKeys(first, last, *keys); });
+
+			}//end if
+
+			else
+			{
+				*done = ParseKeys(first, last, *keys);
+
+			}//end else
+
+		}//end for
+
+		pool->Wait(group);
+
+		for (size_t i = 0; i < numSlices; ++i)
+		{
+			if (!parsed[i])
+			{
+				throw FileException();
+
+			}//end if
+
+			count += (int)slices[i].size();
+
+		}//end for
+
+		text.clear();
+		text.shrink_to_fit();
+		block = new node[max(count, 1)];
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	//rebuild the tree the preorder describes: path holds the nodes whose right subtree is still open, largest
+	//key at the bottom. a key larger than the top closes every smaller node and becomes the right child of the
+	//last one closed, otherwise it is the left child of the top. low is the key of the last node closed, and
+	//every later key belongs to its right subtree, so a key at or below it means the file is not a preorder.
+	//depths runs alongside path, and the rebuild gives up on a tree deeper than limit: a chain would leave
+	//every Find O(N), and deep enough to overflow the stack of the recursive functions
+
+	vector<node*> path;
+	vector<int> depths;		//depth of every node on path
+	bool preorder = true;
+	bool shallow = true;
+	bool closed = false;
+	KeyType low = KeyType();
+	int made = 0;
+	int limit = 2 * (int)ceil(log2(count + 1.0)) + 2;
+
+	try
+	{
+		for (size_t i = 0; i < slices.size() && preorder && shallow; ++i)
+		{
+			for (size_t j = 0; j < slices[i].size() && preorder && shallow; ++j)
+			{
+				node* temp = &block[made];
+				node* parent = nullptr;
+				int depth = 0;
+
+				temp->data = slices[i][j];
+				temp->left = nullptr;
+				temp->right = nullptr;
+				temp->inBlock = true;
+
+				while (!path.empty() && path.back()->data.key < temp->data.key)
+				{
+					parent = path.back();
+					depth = depths.back() + 1;
+					path.pop_back();
+					depths.pop_back();
+
+				}//end while
+
+				if ((closed && !(low < temp->data.key)) || (!path.empty() && path.back()->data.key == temp->data.key))
+				{
+					preorder = false;
+
+				}//end if
+
+				else if (parent != nullptr)
+				{
+					parent->right = temp;
+					low = parent->data.key;
+					closed = true;
+
+				}//end else if
+
+				else if (!path.empty())
+				{
+					path.back()->left = temp;
+					depth = depths.back() + 1;
+
+				}//end else if
+
+				shallow = (depth <= limit);
+				path.push_back(temp);
+				depths.push_back(depth);
+				++made;
+
+			}//end for
+
+		}//end for
+
+		if (preorder && shallow && loaded.hashIndex != nullptr)
+		{
+			loaded.hashIndex->Reserve(count);
+
+		}//end if
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		delete[] block;
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	if (!preorder || !shallow)
+	{
+		//some other order of keys, or a preorder of a tree too deep to keep (a sorted file describes a chain):
+		//load it balanced instead
+
+		vector<ItemType> items;
+
+		delete[] block;
+		try
+		{
+			items.reserve(count);
+			for (size_t i = 0; i < slices.size(); ++i)
+			{
+				items.insert(items.end(), slices[i].begin(), slices[i].end());
+				vector<ItemType>().swap(slices[i]);
+
+			}//end for
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			throw OutOfMemoryException();
+
+		}//end catch
+
+		loaded.BulkLoad(items.data(), count, DUPLICATE_ERROR);
+		FinishLoad(loaded);
+		return;
+
+	}//end if
+
+	if (count == 0)
+	{
+		delete[] block;
+		FinishLoad(loaded);
+		return;
+
+	}//end if
+
+	loaded.OwnBlock(block);		//frees block if it throws
+	loaded.root = block;
+	loaded.length = count;
+	STAT_ADD(blockAllocations, 1);
+
+	if (loaded.hashIndex != nullptr)
+	{
+		loaded.IndexTree();
+
+	}//end if
+
+	if (loaded.filter != nullptr)
+	{
+		loaded.FilterTree(count);
+
+	}//end if
+
+	FinishLoad(loaded);
+
+}//end LoadFile
+
+
+/*****************************************************************************************************/
+
+//A compressed file is the magic, the blocks, the index and a trailer. Integers are little endian. A block
+//holds the gaps between its keys less one as varints (its first key is in the index). An index entry is the
+//first key (8 bytes), the number of keys (4) and the offset of the block (8). The trailer is the offset of
+//the index (8), the number of keys (8), the number of blocks (4) and the magic again
+static const char COMPRESSED_MAGIC[4] = { 'O', 'L', 'Z', '1' };
+static const int MAGIC_BYTES = 4;
+static const int INDEX_ENTRY_BYTES = 20;
+static const int TRAILER_BYTES = 24;
+
+//keys per block, and blocks decoded by one task
+static const int COMPRESSED_BLOCK = 4096;
+static const int DECODE_BLOCKS = 16;
+
+//one entry of the index of a compressed file
+struct CompressedBlock
+{
+	KeyType first;				//first key of the block
+	int count;					//keys in the block
+	unsigned long long offset;	//file offset of the block
+	unsigned long long end;		//file offset just past the block
+};
+
+
+//Pre: 0 < bytes <= 8
+//Post: the low bytes of value have been appended to out, least significant first
+static void PutFixed(	/*in*/unsigned long long value,			//value to write
+						/*in*/int bytes,						//bytes to write
+						/*inout*/vector<unsigned char>& out)	//buffer to append to
+{
+	for (int i = 0; i < bytes; ++i)
+	{
+		out.push_back((unsigned char)(value >> (8 * i)));
+
+	}//end for
+
+}//end PutFixed
+
+
+//Pre: in holds at least bytes bytes, 0 < bytes <= 8
+//Post: returns the value PutFixed wrote to in to the caller
+static unsigned long long GetFixed(	/*in*/const unsigned char* in,	//bytes to read
+									/*in*/int bytes)				//bytes to read
+{
+	unsigned long long value = 0;
+
+	for (int i = 0; i < bytes; ++i)
+	{
+		value |= (unsigned long long)in[i] << (8 * i);
+
+	}//end for
+
+	return value;
+
+}//end GetFixed
+
+
+//Pre: none
+//Post: value has been appended to out seven bits a byte, low bits first, the high bit set on every byte but
+//		the last
+static void PutVarint(	/*in*/unsigned long long value,			//value to write
+						/*inout*/vector<unsigned char>& out)	//buffer to append to
+{
+	while (value >= 0x80)
+	{
+		out.push_back((unsigned char)(value | 0x80));
+		value >>= 7;
+
+	}//end while
+
+	out.push_back((unsigned char)value);
+
+}//end PutVarint
+
+
+//Pre: first <= last
+//Post: value holds the varint at first, and first has moved past it. returns false to the caller if the varint
+//		runs past last or does not fit in 64 bits
+static bool GetVarint(	/*inout*/const unsigned char*& first,	//next byte to read
+						/*in*/const unsigned char* last,		//end of the bytes
+						/*out*/unsigned long long& value)		//value read
+{
+	value = 0;
+
+	for (int shift = 0; shift < 64 && first != last; shift += 7)
+	{
+		unsigned char byte = *first++;
+
+		value |= (unsigned long long)(byte & 0x7f) << shift;
+		if ((byte & 0x80) == 0)
+		{
+			return true;
+
+		}//end if
+
+	}//end for
+
+	return false;
+
+}//end GetVarint
+
+
+//Pre: first and last bound the bytes of block, out has room for block.count items
+//Post: out holds the keys of block. returns false to the caller if the bytes are not exactly block.count
+//		increasing keys
+static bool DecodeBlock(/*in*/const unsigned char* first,	//first byte of the block
+						/*in*/const unsigned char* last,	//end of the block
+						/*in*/const CompressedBlock& block,	//index entry of the block
+						/*out*/ItemType out[])				//keys decoded
+{
+	unsigned long long gap;
+
+	out[0].key = block.first;
+	for (int i = 1; i < block.count; ++i)
+	{
+		if (!GetVarint(first, last, gap))
+		{
+			return false;
+
+		}//end if
+
+		//the gap is taken modulo 2^64, so a key that wrapped around is caught by the order check
+
+		out[i].key = (KeyType)((unsigned long long)out[i - 1].key + gap + 1);
+		if (!(out[i - 1].key < out[i].key))
+		{
+			return false;
+
+		}//end if
+
+	}//end for
+
+	return first == last;
+
+}//end DecodeBlock
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: the keys have been written to fileName in order in the compressed format. Keys go in blocks of
+//		COMPRESSED_BLOCK, each one the varint encoded gaps between its keys, so dense increasing keys take
+//		one or two bytes each. An index at the end of the file holds the first key, the number of keys and
+//		the offset of every block, so any block decodes on its own. counts and payloads are not written
+//Exceptions thrown: throws a FileException if fileName can not be opened or written
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+void OrdListClass::SaveCompressed(/*in*/string fileName) const //file to write
+{
+	ofstream outdat(fileName, ios::binary);
+
+	if (!outdat)
+	{
+		throw FileException();
+
+	}//end if
+
+	try
+	{
+		vector<unsigned char> bytes;		//the block being encoded
+		vector<unsigned char> index;
+		vector<node*> path;
+		unsigned long long offset = MAGIC_BYTES;
+		KeyType first = KeyType();
+		KeyType previous = KeyType();
+		int inBlock = 0;
+		int numBlocks = 0;
+
+		outdat.write(COMPRESSED_MAGIC, MAGIC_BYTES);
+
+		PushLeft(root, path);
+		while (!path.empty() || inBlock > 0)
+		{
+			//a block is closed when it is full or the walk is over
+
+			if (inBlock == COMPRESSED_BLOCK || (path.empty() && inBlock > 0))
+			{
+				PutFixed((unsigned long long)first, 8, index);
+				PutFixed((unsigned long long)inBlock, 4, index);
+				PutFixed(offset, 8, index);
+				outdat.write((const char*)bytes.data(), bytes.size());
+				offset += bytes.size();
+				bytes.clear();
+				inBlock = 0;
+				++numBlocks;
+
+			}//end if
+
+			else
+			{
+				node* trav = NextInOrder(path);
+
+				if (inBlock == 0)
+				{
+					first = trav->data.key;
+
+				}//end if
+
+				else
+				{
+					PutVarint((unsigned long long)trav->data.key - (unsigned long long)previous - 1, bytes);
+
+				}//end else
+
+				previous = trav->data.key;
+				++inBlock;
+
+			}//end else
+
+		}//end while
+
+		PutFixed(offset, 8, index);
+		PutFixed((unsigned long long)length, 8, index);
+		PutFixed((unsigned long long)numBlocks, 4, index);
+		index.insert(index.end(), COMPRESSED_MAGIC, COMPRESSED_MAGIC + MAGIC_BYTES);
+		outdat.write((const char*)index.data(), index.size());
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	outdat.close();
+	if (!outdat)
+	{
+		throw FileException();
+
+	}//end if
+
+}//end SaveCompressed
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: the list holds every key of the compressed file fileName as a balanced tree, see LoadCompressedRange
+//Exceptions thrown: throws a FileException if fileName can not be read or is not a compressed file
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+//					 the list is not changed when an exception is thrown
+void OrdListClass::LoadCompressed(/*in*/string fileName) //file to read
+{
+	LoadCompressedRange(fileName, numeric_limits<KeyType>::lowest(), numeric_limits<KeyType>::max());
+
+}//end LoadCompressed
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, fileName was written by SaveCompressed
+//Post: the list holds the keys of fileName in [low, high] as a balanced tree built by BuildFromSorted.
+//		Only the trailer, the index and the blocks whose key range meets [low, high] are read, in one
+//		read each, and the blocks are decoded in parallel on the pool
+//Exceptions thrown: throws a FileException if fileName can not be read or is not a compressed file
+//					 throws an OutOfMemoryException when there is no more space left on the heap
+//					 the list is not changed when an exception is thrown
+void OrdListClass::LoadCompressedRange(	/*in*/string fileName,		//file to read
+										/*in*/KeyType low,			//smallest key to load
+										/*in*/KeyType high)			//largest key to load
+{
+	ifstream indat(fileName, ios::binary | ios::ate);
+	vector<ItemType> items;
+	size_t start = 0;
+	size_t stop = 0;
+
+	if (!indat)
+	{
+		throw FileException();
+
+	}//end if
+
+	try
+	{
+		unsigned long long size = (unsigned long long)indat.tellg();
+		unsigned char magic[MAGIC_BYTES];
+		unsigned char trailer[TRAILER_BYTES];
+
+		if (size < MAGIC_BYTES + TRAILER_BYTES || !indat.seekg(0).read((char*)magic, MAGIC_BYTES) ||
+			!indat.seekg(size - TRAILER_BYTES).read((char*)trailer, TRAILER_BYTES) ||
+			!equal(magic, magic + MAGIC_BYTES, COMPRESSED_MAGIC) ||
+			!equal(trailer + 20, trailer + 24, COMPRESSED_MAGIC))
+		{
+			throw FileException();
+
+		}//end if
+
+		unsigned long long indexOffset = GetFixed(trailer, 8);
+		unsigned long long total = GetFixed(trailer + 8, 8);
+		unsigned long long numBlocks = GetFixed(trailer + 16, 4);
+
+		if (total > (unsigned long long)numeric_limits<int>::max() || indexOffset < MAGIC_BYTES ||
+			indexOffset > size || (size - indexOffset - TRAILER_BYTES) != numBlocks * INDEX_ENTRY_BYTES)
+		{
+			throw FileException();
+
+		}//end if
+
+		//read and check the whole index, it is small next to the blocks
+
+		vector<unsigned char> index((size_t)(numBlocks * INDEX_ENTRY_BYTES));
+		vector<CompressedBlock> blocks((size_t)numBlocks);
+		unsigned long long counted = 0;
+
+		if (!indat.seekg(indexOffset).read((char*)index.data(), index.size()))
+		{
+			throw FileException();
+
+		}//end if
+
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			const unsigned char* entry = index.data() + i * INDEX_ENTRY_BYTES;
+
+			blocks[i].first = (KeyType)GetFixed(entry, 8);
+			blocks[i].count = (int)GetFixed(entry + 8, 4);
+			blocks[i].offset = GetFixed(entry + 12, 8);
+			blocks[i].end = (i + 1 < blocks.size()) ? GetFixed(entry + 12 + INDEX_ENTRY_BYTES, 8) : indexOffset;
+			counted += (unsigned long long)blocks[i].count;
+
+			if (blocks[i].count <= 0 || blocks[i].offset > blocks[i].end || blocks[i].end > indexOffset ||
+				blocks[i].offset != ((i > 0) ? blocks[i - 1].end : MAGIC_BYTES) ||
+				(i > 0 && !(blocks[i - 1].first < blocks[i].first)))
+			{
+				throw FileException();
+
+			}//end if
+
+		}//end for
+
+		if (counted != total)
+		{
+			throw FileException();
+
+		}//end if
+
+		//the blocks that can hold [low, high] run from the last one starting at or below low to the last
+		//one starting at or below high
+
+		size_t first = 0;
+		size_t last = 0;
+
+		while (last < blocks.size() && !(high < blocks[last].first))
+		{
+			if (!(low < blocks[last].first))
+			{
+				first = last;
+
+			}//end if
+
+			++last;
+
+		}//end while
+
+		if (high < low || last == 0)
+		{
+			first = last;
+
+		}//end if
+
+		if (first < last)
+		{
+			vector<unsigned char> bytes((size_t)(blocks[last - 1].end - blocks[first].offset));
+			vector<size_t> position(last - first + 1, 0);
+			vector<char> decoded(last - first, false);
+			ThreadPoolClass* pool = ReturnPool();
+			TaskGroup group;
+			WaitGuard guard(pool, group);
+
+			if (!indat.seekg(blocks[first].offset).read((char*)bytes.data(), bytes.size()))
+			{
+				throw FileException();
+
+			}//end if
+
+			for (size_t i = first; i < last; ++i)
+			{
+				position[i - first + 1] = position[i - first] + blocks[i].count;
+
+			}//end for
+
+			items.resize(position.back());
+
+			for (size_t i = first; i < last; i += DECODE_BLOCKS)
+			{
+				size_t end = min(i + DECODE_BLOCKS, last);
+				auto decode = [&, i, end]()
+				{
+					for (size_t b = i; b < end; ++b)
+					{
+						decoded[b - first] = DecodeBlock(bytes.data() + (blocks[b].offset - blocks[first].offset),
+							bytes.data() + (blocks[b].end - blocks[first].offset), blocks[b], &items[position[b - first]]);
+
+					}//end for
+				};
+
+				if (end < last)
+				{
+					pool->Spawn(group, decode);
+
+				}//end if
+
+				else
+				{
+					decode();
+
+				}//end else
+
+			}//end for
+
+			pool->Wait(group);
+
+			for (size_t i = first; i < last; ++i)
+			{
+				if (!decoded[i - first] || (i + 1 < last && !(items[position[i - first + 1] - 1].key < blocks[i + 1].first)))
+				{
+					throw FileException();
+
+				}//end if
+
+			}//end for
+
+			start = lower_bound(items.begin(), items.end(), low, [](const ItemType& item, KeyType key) { return item.key < key; }) - items.begin();
+			stop = upper_bound(items.begin(), items.end(), high, [](KeyType key, const ItemType& item) { return key < item.key; }) - items.begin();
+			stop = max(start, stop);
+
+		}//end if
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	//BuildFromSorted clears the list before it allocates, so the tree is built in a list of its own and only
+	//swapped in once nothing can fail
+
+	OrdListClass loaded;
+
+	PrepareLoad(loaded);
+	loaded.BuildFromSorted(items.data() + start, (int)(stop - start), false);
+	FinishLoad(loaded);
+
+}//end LoadCompressedRange
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, loaded is a new empty list
+//Post: loaded runs on the same pool as the current list, in the same multiset mode, and keeps a hash index and
+//		a filter like it does, ready for a file to be loaded into it
+//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap
+void OrdListClass::PrepareLoad(/*inout*/OrdListClass& loaded) const //list the file is loaded into
+{
+	loaded.pool = pool;
+	loaded.multiset = multiset;
+	if (hashIndex != nullptr)
+	{
+		loaded.SetHashIndex(true, hashIndex->ReturnLoadFactor());
+
+	}//end if
+
+	if (filter != nullptr)
+	{
+		loaded.SetFilter(true, filter->ReturnFalsePositiveRate());
+
+	}//end if
+
+}//end PrepareLoad
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, PrepareLoad has been applied to loaded and a tree built in it
+//Post: the current list holds the tree of loaded, with its index, filter and blocks, and the cursor on the
+//		root. loaded holds the old tree, and frees it when it goes. nothing here can fail
+void OrdListClass::FinishLoad(/*inout*/OrdListClass& loaded) //list the file was loaded into
+{
+	swap(root, loaded.root);
+	swap(length, loaded.length);
+	swap(hashIndex, loaded.hashIndex);
+	swap(filter, loaded.filter);
+	swap(payloads, loaded.payloads);
+	swap(nodeBlocks, loaded.nodeBlocks);
+	++version;
+	maxLength = length;
+	currPos = root;
+	prevPos = nullptr;
+	cursorPending = false;
+	copyOf = nullptr;
+
+}//end FinishLoad
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns a new node pointer to the caller with all values set to nullptr
+//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap
+node* OrdListClass::Allocate()
+{
+	try
+	{
+		node* temp = new node;
+		temp->left = nullptr;
+		temp->right = nullptr;
+		STAT_ADD(allocations, 1);
+		return temp;
+
+	}//end try
+
+	catch (bad_alloc*)
+	{
+		throw new OutOfMemoryException;
+
+	}//end catch
+
+}//end Allocate
+
+
+/*****************************************************************************************************/
+
+//wrapped function
+//Pre: OrdListClass has been instantiated, trav is the root
+//Post: traverses the list and returns the number of elements to the caller
+int OrdListClass::rLength(/*in*/node *trav,				//starting node
+						 /*inout*/int &numNodes) const	//number of nodes in the tree
+{
+	if (trav != nullptr)				
+	{
+		numNodes++;						//increment counter
+		rLength(trav->left, numNodes);	//go left
+		rLength(trav->right, numNodes);	//go right
+
+	}//end if
+
+	return numNodes;
+
+}//end rLength
+
+
+/*****************************************************************************************************/
+
+//Pre: Find has been called on the node that needs to be deleted. OrdListClass has been instantiated
+//Post: given a node pointer, delete the current node maintaining proper order
+//when prevPos is a nullptr, currPos is pointing to the root
+//wrapped function (sort of) will only call itself at most one additional time
+void OrdListClass::rDelete(/*inout*/node *&trav)  //node to delete from the current object
+{
+	//a node with at most one child is unlinked below, so its key leaves the index and its payload is freed.
+	//Erase skips the entry if it already points at another node (the two child case copied the key there)
+	if (trav->left == nullptr || trav->right == nullptr)
+	{
+		if (hashIndex != nullptr)
+		{
+			hashIndex->Erase(trav->data.key, trav);
+
+		}//end if
+
+		if (payloads != nullptr)
+		{
+			payloads->Release(trav->payload);
+			trav->payload = NO_PAYLOAD;
+
+		}//end if
+
+	}//end if
+
+	if (trav->left == nullptr && trav->right == nullptr) //no children
+	{
+		if (trav != root)			//no children, and at the root therefore the root is the only node left in the tree, need to delete that node so go to else..
+		{
+			if (prevPos->left == trav)
+			{
+				prevPos->left = nullptr;
+
+			}//end if
+
+			else
+			{
+				prevPos->right = nullptr;
+
+			}//end else
+
+		}//end if
+
+		else
+		{
+			root = nullptr;
+			prevPos = nullptr;
+
+		}//end else
+
+		Deallocate(trav);
+		--length;
+		trav = root;
+
+	}//end if
+
+	else if (trav->left != nullptr && trav->right == nullptr) //Node we are trying to delete has a left child
+	{
+		node *temp = trav;
+
+		if (trav != root)
+		{
+			if (prevPos->left == trav) //finding its parent to link together
+			{
+				prevPos->left = trav->left;
+
+			}//end if
+
+			else
+			{
+				prevPos->right = trav->left;
+
+			}//end else
+
+		}//end if
+
+		else
+		{
+			root = trav->left;
+			prevPos = nullptr;
+
+		}//end else
+
+		trav = root;
+		Deallocate(temp);
+		--length;
+
+	}//end else if
+
+	else if (trav->left == nullptr && trav->right != nullptr) //node we are trying to delete has a right child
+	{
+		node *temp = trav;
+
+		if (trav != root)
+		{
+			if (prevPos->left == trav)
+			{
+				prevPos->left = trav->right;
+
+			}//end if
+
+			else
+			{
+				prevPos->right = trav->right;
+
+			}//end else
+
+		}//end if
+
+		else
+		{
+			root = trav->right;
+			prevPos = nullptr;
+
+		}//end else
+
+		trav = root;
+		Deallocate(temp);
+		--length;
+
+	}//end else if
+
+	else //node has two children. need to find in order precursor, copy its value, then process delete on the node that was copied
+	{
+		node *temp = trav;
+		trav = trav->right;
+
+		while (trav->left != nullptr)
+		{
+			trav = trav->left;
+
+		}//end while
+
+		Locate(trav->data.key); //to set prev pos
+		if (hashIndex != nullptr)
+		{
+			hashIndex->Erase(temp->data.key, temp);
+
+		}//end if
+
+		temp->data = trav->data;
+		temp->count = trav->count;		//every copy of the successor moves up with it
+		if (payloads != nullptr)
+		{
+			payloads->Release(temp->payload);
+
+		}//end if
+
+		temp->payload = trav->payload;		//the payload moves along with the item
+		trav->payload = NO_PAYLOAD;
+		IndexNode(temp);		//the successor's key now lives in temp, so freeing trav below leaves it alone
+		rDelete(trav);
+
+	}//end else
+
+}//end rDelete
+
+
+/*****************************************************************************************************/
+
+//Pre: rtRoot is a valid root of a tree, OrdListClass has been instantiated
+//Post: does a pre-order traversal of rtRoot and inserts them into the current object, with copies of their
+//		payloads from the arena from (may be nullptr) and their counts
+void OrdListClass::rPreOrderTrav(	/*in*/node *rtRoot,						//root of tree to copy
+									/*in*/const PayloadArenaClass* from)	//arena the payloads of rtRoot's tree are in
+{
+	if (rtRoot != nullptr)
+	{
+		Locate(rtRoot->data.key);
+		Insert(rtRoot->data);
+		currPos->count = rtRoot->count;
+		if (from != nullptr && rtRoot->payload != NO_PAYLOAD)
+		{
+			PayloadView temp = from->View(rtRoot->payload);
+			SetPayload(temp.data, temp.size);		//Insert left currPos on the new node
+
+		}//end if
+
+		rPreOrderTrav(rtRoot->left, from);
+		rPreOrderTrav(rtRoot->right, from);
+
+	}//end if
+
+}//end rPreOrderTrav
+
+
+/*****************************************************************************************************/
+
+//Pre: items is an ordered array with ItemTypes to be added to list
+//		list is a valid OrdListClass
+//		start is the starting index of the search (init 0) 
+//		end is the end of the search (init items.size)
+//Post: creates a BST from an ordered list of data and returns it to the caller by ref
+void OrdListClass::CreateTree(	/*in*/ItemType items[],			//sorted list of elements 
+								/*inout*/OrdListClass& list,	//list to be created
+								/*in*/int start,				//starting index
+								/*in*/int end) const			//ending index
+{
+
+	//slightly modified binary search. Instead of checking if the mp is our target, we add the array's mp value
+	//to the tree. this creates the most balanced complete tree possible given a sorted array (i think)
+	if (start <= end)
+	{
+		int mp = (start + end) / 2;
+
+		list.Locate(items[mp].key);
+		list.Insert(items[mp]);
+		CreateTree(items, list, start, mp - 1);
+		CreateTree(items, list, mp + 1, end);
+
+	}//end if
+
+}//end CreateTree
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, visit is a valid FunctonType, trav is typically root (init)
+//Post: Traverses the list in order visiting each node. client defines what a "visit" is
+void OrdListClass::rInOrderTrav(/*inout*/FunctionType visit,	//function pointer (passes control to client)
+								/*in*/node* trav)				//current node
+{
+	if (trav != nullptr)
+	{
+		rInOrderTrav(visit, trav->left);
+		visit(trav->data);
+		rInOrderTrav(visit, trav->right);
+
+	}//end if
+
+}//end InOrderTrav
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, visit is a valid FunctonTypeFile, trav is typically root (init)
+//Post: Traverses the list in order visiting each node. client defines what a "visit" is
+void OrdListClass::rFileTrav(	/*inout*/FunctionTypeFile visit, //function pointer (passes control to client) 
+								/*in*/node* trav,				 //current node
+								/*inout*/ofstream& outdat)		 //out file stream
+{
+	//Prints each node in a pre-order fashion so that when the nodes are read back in to a class,
+	//An identical tree will have been created
+
+
+	if (trav != nullptr)
+	{
+		visit(trav->data, outdat);
+		rFileTrav(visit, trav->left, outdat);
+		rFileTrav(visit, trav->right, outdat);
+		
+	}//end if
+
+}//end rFileTrav
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, visit is a valid FunctonType, trav is typically root (init)
+//Post: Traverses the list backwards visiting each node. client defines what a "visit" is
+void OrdListClass::rBackwardInOrderTrav(/*inout*/FunctionType visit,	//function pointer (passes control to client)
+										/*in*/node* trav)				//current node
+{
+	//Visit in  a RNL fashion
+
+
+	if (trav != nullptr)
+	{
+		rBackwardInOrderTrav(visit, trav->right);
+		visit(trav->data);
+		rBackwardInOrderTrav(visit, trav->left);
+
+	}//end if
+
+}//end rBackwardInOrderTrav
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated. key is a valid KeyType
+//Post: returns true to the caller if key is found in the current object, false otherwise. wrapped function
+bool OrdListClass::rFind(/*in*/KeyType key) //key to find
+{
+
+	if (currPos != nullptr)
+	{
+		STAT_ADD(findComparisons, 1);
+
+		if (currPos->data.key == key)
+		{
+			if (currPos == root)
+			{
+				prevPos = nullptr;
+
+			}//end if
+
+			return true;
+
+		}//end if 
+
+		else if (currPos->data.key < key) //go right
+		{
+			prevPos = currPos;
+			currPos = currPos->right;
+			return rFind(key);
+
+		}//end else if
+
+		else
+		{
+			prevPos = currPos;
+			currPos = currPos->left;
+			return rFind(key);
+
+		}//end else
+
+	}//end if
+
+	else
+	{
+		return false;
+
+	}//end else
+
+}//end rFind
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns the pool the parallel functions run on
+ThreadPoolClass* OrdListClass::ReturnPool() const
+{
+	if (pool != nullptr)
+		return pool;
+	else
+		return ThreadPoolClass::Default();
+
+}//end ReturnPool
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is a node of the current object that has been unlinked from the tree
+//Post: returns trav to the freestore. a node carved from a block is left to the block, which goes when the
+//		list that owns it is cleared
+void OrdListClass::Deallocate(/*in*/node* trav) //node to release
+{
+	STAT_ADD(deallocations, 1);
+
+	if (!trav->inBlock)
+	{
+		delete trav;
+
+	}//end if
+
+}//end Deallocate
+
+
+/*****************************************************************************************************/
+
+//Pre: block was allocated with new[] and every node of it is tagged inBlock
+//Post: the list owns block. it is freed once the list, and every list its nodes have moved to, has been cleared
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. block has been freed then
+void OrdListClass::OwnBlock(/*in*/node* block) //first node of the block
+{
+	try
+	{
+		nodeBlocks.push_back(shared_ptr<node>(block, default_delete<node[]>()));		//frees block if it throws
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end OwnBlock
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is the root of a subtree that has been unlinked from the tree (or is the whole tree)
+//Post: every node of the subtree at trav has been deallocated
+void OrdListClass::FreeTree(/*in*/node* trav) //root of the subtree to free
+{
+	//iterative so that a degenerate (chain shaped) tree can not overflow the stack. a left child is rotated
+	//up until the top has none, then the top is freed and its right subtree comes next: no stack is needed,
+	//so freeing can not run out of memory (the destructor and the swap in LoadCompressedRange rely on it)
+
+	while (trav != nullptr)
+	{
+		node* temp = trav->left;
+
+		if (temp != nullptr)
+		{
+			trav->left = temp->right;
+			temp->right = trav;
+			trav = temp;
+
+		}//end if
+
+		else
+		{
+			temp = trav->right;
+			Deallocate(trav);
+			trav = temp;
+
+		}//end else
+
+	}//end while
+
+}//end FreeTree
+
+
+/*****************************************************************************************************/
+
+//Pre: order[start..end] are indexes into items of distinct keys, sorted by key, that are not in the list
+//Post: those items have been inserted, the midpoint of the range first, and their status set to INSERTED
+void OrdListClass::InsertMidpoints(	/*in*/const ItemType items[],		//batch being inserted
+									/*in*/const int order[],			//indexes of items in key order
+									/*in*/int start,					//starting index into order
+									/*in*/int end,						//ending index into order
+									/*out*/InsertStatusType status[])	//outcome for each item
+{
+	//same midpoint order as CreateTree, a sorted run inserted front to back would hang off the tree as a chain
+
+	if (start <= end)
+	{
+		int mp = start + (end - start) / 2;
+
+		Locate(items[order[mp]].key);
+		Insert(items[order[mp]]);
+		status[order[mp]] = INSERTED;
+		InsertMidpoints(items, order, start, mp - 1, status);
+		InsertMidpoints(items, order, mp + 1, end, status);
+
+	}//end if
+
+}//end InsertMidpoints
+
+
+/*****************************************************************************************************/
+
+//Pre: the node for key has just been linked into the tree, balanceMode is BALANCE_SCAPEGOAT
+//Post: if the node is deeper than log(N) / log(1 / alpha), the subtree of its scapegoat ancestor has been
+//		rebuilt balanced. currPos and prevPos are left on the node for key. the path is kept in insertPath, so
+//		once it has grown to the height of the tree an insert allocates nothing here. if the rebuild runs out
+//		of memory the tree is left as it was, a later insert finds the scapegoat again
+void OrdListClass::ScapegoatInsert(/*in*/KeyType key) //key just inserted
+{
+	if (length > maxLength)
+	{
+		maxLength = length;
+
+	}//end if
+
+	//Insert only knows the parent, walk down again for the whole path
+
+	vector<node*>& path = insertPath;
+	node* trav = root;
+
+	try
+	{
+		path.clear();
+		while (trav != nullptr && trav->data.key != key)
+		{
+			path.push_back(trav);
+			trav = (key < trav->data.key) ? trav->left : trav->right;
+
+		}//end while
+
+		path.push_back(trav);
+
+		int depth = (int)path.size() - 1;
+		if (length < 2 || depth <= log((double)length) / log(1.0 / alpha))
+		{
+			return;
+
+		}//end if
+
+		//climb towards the root until a child is too heavy for its parent. sizes are counted on the way up, so
+		//the cost is the size of the scapegoat's subtree, which the rebuild pays anyway
+
+		int childSize = 1;
+		for (int i = depth - 1; i >= 0; --i)
+		{
+			node* sibling = (path[i]->left == path[i + 1]) ? path[i]->right : path[i]->left;
+			int siblingSize = 0;
+			rLength(sibling, siblingSize);
+
+			int size = childSize + siblingSize + 1;
+			if (childSize > alpha * size)
+			{
+				node* rebuilt = RebuildSubtree(path[i]);
+				++version;
+
+				if (i == 0)
+					root = rebuilt;
+				else if (path[i - 1]->left == path[i])
+					path[i - 1]->left = rebuilt;
+				else
+					path[i - 1]->right = rebuilt;
+
+				break;
+
+			}//end if
+
+			childSize = size;
+
+		}//end for
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		//nothing has been relinked yet, the insert stands with the tree a little deeper than the bound
+
+		return;
+
+	}//end catch
+
+	Locate(key);
+
+}//end ScapegoatInsert
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is the root of a subtree of the current object (may be null)
+//Post: relinks the nodes of the subtree at trav into a perfectly balanced subtree and returns its root to the
+//		caller. no node is allocated or freed and no item is copied. the caller links the new root in place
+//		of trav
+node* OrdListClass::RebuildSubtree(/*in*/node* trav) //root of the subtree to rebuild
+{
+	vector<node*> nodes;
+	vector<node*> path;
+
+	while (trav != nullptr || !path.empty())
+	{
+		while (trav != nullptr)
+		{
+			path.push_back(trav);
+			trav = trav->left;
+
+		}//end while
+
+		trav = path.back();
+		path.pop_back();
+		nodes.push_back(trav);
+		trav = trav->right;
+
+	}//end while
+
+	return LinkMidpoints(nodes, 0, (int)nodes.size() - 1);
+
+}//end RebuildSubtree
+
+
+/*****************************************************************************************************/
+
+//Pre: pseudoRoot->right is a vine (or partly folded vine) with at least 2 * count nodes on its right spine
+//Post: one Day-Stout-Warren compression pass: every other node of the first 2 * count nodes of the right
+//		spine has been rotated left under its successor
+void OrdListClass::Compress(/*inout*/node* pseudoRoot,	//node above the real root
+							/*in*/int count)			//rotations to make
+{
+	node* scanner = pseudoRoot;
+
+	for (int i = 0; i < count; ++i)
+	{
+		node* child = scanner->right;
+		scanner->right = child->right;
+		scanner = scanner->right;
+		child->right = scanner->left;
+		scanner->left = child;
+
+	}//end for
+
+}//end Compress
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key is a valid KeyType
+//Post: returns true to the caller if the key was found, false otherwise. currPos is either set to the found
+//		node or where the node would appear in the list, prevPos to its parent. Never reshapes the tree, so
+//		the cursor functions use it instead of Find
+bool OrdListClass::Locate(/*in*/KeyType key) //key to find
+{
+	cursorPending = false;
+	copyOf = nullptr;
+	currPos = root;
+	return rFind(key);
+
+}//end Locate
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key is a valid KeyType
+//Post: top-down splay (Sleator and Tarjan): the node for key, or the last node on its search path, has been
+//		rotated up to the root. if key is not in the list, every key in root's left subtree is smaller than key
+//		and every key in its right subtree is greater
+void OrdListClass::Splay(/*in*/KeyType key) //key to splay
+{
+	//the nodes passed on the way down are hung on two side trees: leftTail collects the ones smaller than key,
+	//rightTail the ones greater. header.right is the root of the smaller tree, header.left of the greater one
+
+	node header;
+	node* leftTail = &header;
+	node* rightTail = &header;
+	node* trav = root;
+
+	if (trav == nullptr)
+	{
+		return;
+
+	}//end if
+
+	header.left = nullptr;
+	header.right = nullptr;
+
+	while (true)
+	{
+		STAT_ADD(findComparisons, 1);
+
+		if (key < trav->data.key)
+		{
+			if (trav->left == nullptr)
+			{
+				break;
+
+			}//end if
+
+			if (key < trav->left->data.key) //zig-zig: rotate right first
+			{
+				node* temp = trav->left;
+				trav->left = temp->right;
+				temp->right = trav;
+				trav = temp;
+
+				if (trav->left == nullptr)
+				{
+					break;
+
+				}//end if
+
+			}//end if
+
+			rightTail->left = trav; //link right
+			rightTail = trav;
+			trav = trav->left;
+
+		}//end if
+
+		else if (trav->data.key < key)
+		{
+			if (trav->right == nullptr)
+			{
+				break;
+
+			}//end if
+
+			if (trav->right->data.key < key) //zag-zag: rotate left first
+			{
+				node* temp = trav->right;
+				trav->right = temp->left;
+				temp->left = trav;
+				trav = temp;
+
+				if (trav->right == nullptr)
+				{
+					break;
+
+				}//end if
+
+			}//end if
+
+			leftTail->right = trav; //link left
+			leftTail = trav;
+			trav = trav->right;
+
+		}//end else if
+
+		else
+		{
+			break;
+
+		}//end else
+
+	}//end while
+
+	//reassemble
+	++version;
+	leftTail->right = trav->left;
+	rightTail->left = trav->right;
+	trav->left = header.right;
+	trav->right = header.left;
+	root = trav;
+
+}//end Splay
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is a child of the node on top of finger (or the root when finger is empty)
+//Post: trav has been pushed on the finger path, with the key range its subtree is known to lie in
+void OrdListClass::FingerPush(/*in*/node* trav) //node the search has just moved to
+{
+	FingerEntry temp = { trav, 0, 0, false, false };
+
+	if (!finger.empty())
+	{
+		//a left child inherits its parent's lower bound and is capped by the parent's key, a right child the
+		//other way around
+
+		temp = finger.back();
+		temp.trav = trav;
+
+		if (trav == finger.back().trav->left)
+		{
+			temp.high = finger.back().trav->data.key;
+			temp.hasHigh = true;
+
+		}//end if
+
+		else
+		{
+			temp.low = finger.back().trav->data.key;
+			temp.hasLow = true;
+
+		}//end else
+
+	}//end if
+
+	finger.push_back(temp);
+
+}//end FingerPush
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: if a Find answered from the hash index, prevPos has been set to the parent of currPos (or of where
+//		the key would go). Called by every function that relies on prevPos
+void OrdListClass::SettleCursor()
+{
+	//the index knows the node but not its parent, so the descent is put off until something needs it
+
+	if (cursorPending)
+	{
+		Locate(pendingKey);
+
+	}//end if
+
+}//end SettleCursor
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, hashIndex is not nullptr
+//Post: the hash index holds exactly the nodes of the tree
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. the index is dropped
+void OrdListClass::IndexTree()
+{
+	//an index missing any node would make Find lie, so on failure there is no index rather than a wrong one
+
+	vector<node*> pending;
+
+	try
+	{
+		hashIndex->Clear();
+		hashIndex->Reserve(length);
+
+		if (root != nullptr)
+		{
+			pending.push_back(root);
+
+		}//end if
+
+		while (!pending.empty())
+		{
+			node* trav = pending.back();
+			pending.pop_back();
+			hashIndex->Insert(trav->data.key, trav);
+
+			if (trav->left != nullptr)
+			{
+				pending.push_back(trav->left);
+
+			}//end if
+
+			if (trav->right != nullptr)
+			{
+				pending.push_back(trav->right);
+
+			}//end if
+
+		}//end while
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		delete hashIndex;
+		hashIndex = nullptr;
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end IndexTree
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, trav is a node of the tree, the index has room for it (Reserve)
+//Post: trav has been entered in the hash index under its key, if there is an index
+void OrdListClass::IndexNode(/*in*/node* trav) //node to enter
+{
+	if (hashIndex != nullptr)
+	{
+		hashIndex->Insert(trav->data.key, trav);
+
+	}//end if
+
+}//end IndexNode
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, key has just been linked into the tree
+//Post: key has been added to the filter, if there is one. a full filter is rebuilt from the tree with room
+//		for twice the keys
+//Exceptions thrown: throws an OutOfMemoryException if the rebuild runs out of memory. the filter is dropped
+void OrdListClass::FilterKey(/*in*/KeyType key) //key just inserted
+{
+	//a cuckoo filter can not grow by itself (it no longer knows its keys), but the tree does
+
+	if (filter != nullptr && !filter->Insert(key))
+	{
+		FilterTree(2 * length);
+
+	}//end if
+
+}//end FilterKey
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated, filter is not nullptr
+//Post: the filter holds exactly the keys of the tree and has room for capacity keys
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. the filter is dropped
+void OrdListClass::FilterTree(/*in*/int capacity) //number of keys to size the filter for
+{
+	//a filter missing any key would make Find lie, so on failure there is no filter rather than a wrong one
+
+	vector<node*> pending;
+
+	try
+	{
+		filter->Reset(capacity);
+
+		if (root != nullptr)
+		{
+			pending.push_back(root);
+
+		}//end if
+
+		while (!pending.empty())
+		{
+			node* trav = pending.back();
+			pending.pop_back();
+
+			if (!filter->Insert(trav->data.key))
+			{
+				//unlucky eviction chain, start over with more room
+				filter->Reset(2 * capacity);
+				capacity *= 2;
+				pending.clear();
+				pending.push_back(root);
+				continue;
+
+			}//end if
+
+			if (trav->left != nullptr)
+			{
+				pending.push_back(trav->left);
+
+			}//end if
+
+			if (trav->right != nullptr)
+			{
+				pending.push_back(trav->right);
+
+			}//end if
+
+		}//end while
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		delete filter;
+		filter = nullptr;
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end FilterTree
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: TryInsert (assign is false) or InsertOrAssign (assign is true) has been carried out and its status
+//		returned to the caller
+InsertStatusType OrdListClass::Upsert(	/*in*/ItemType newItem,	//item to insert
+										/*in*/bool assign)		//true to overwrite an item with the same key
+{
+	//Insert links at the cursor without searching again, so one search that leaves currPos null and
+	//prevPos on the parent is all a new key costs. the search already knows if the key is taken
+
+	TIME_OP(OP_INSERT);
+	bool found;
+
+	if (hashIndex != nullptr && (currPos = hashIndex->Find(newItem.key)) != nullptr)
+	{
+		cursorPending = true;		//the parent is only looked up if something needs it
+		pendingKey = newItem.key;
+		found = true;
+
+	}//end if
+
+	else if (balanceMode == BALANCE_SPLAY)
+	{
+		//Insert splays again, but by then the neighbour of the key is the root and the splay is one step
+		cursorPending = false;
+		Splay(newItem.key);
+		found = (root != nullptr && root->data.key == newItem.key);
+		currPos = root;
+		prevPos = nullptr;
+
+	}//end else if
+
+	else
+	{
+		found = Locate(newItem.key);
+
+	}//end else
+
+	if (found)
+	{
+		if (assign)
+		{
+			currPos->data = newItem;
+			return ASSIGNED;
+
+		}//end if
+
+		if (multiset)
+		{
+			++currPos->count;
+			return COUNTED;
+
+		}//end if
+
+		return DUPLICATE_KEY;
+
+	}//end if
+
+	Insert(newItem);
+	return INSERTED;
+
+}//end Upsert
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is a node of the current object that has been unlinked from the tree
+//Post: trav's key has left the hash index and the filter, its payload has been released, and trav has been
+//		deallocated and taken off length
+void OrdListClass::ReleaseNode(/*in*/node* trav) //node to release
+{
+	if (hashIndex != nullptr)
+	{
+		hashIndex->Erase(trav->data.key, trav);
+
+	}//end if
+
+	if (filter != nullptr)
+	{
+		filter->Erase(trav->data.key);
+
+	}//end if
+
+	if (payloads != nullptr)
+	{
+		payloads->Release(trav->payload);
+
+	}//end if
+
+	Deallocate(trav);
+	--length;
+
+}//end ReleaseNode
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is the root of a subtree of the current object that has been unlinked from the tree
+//Post: ReleaseNode has been applied to every node of the subtree. returns how many to the caller
+int OrdListClass::ReleaseTree(/*in*/node* trav) //root of the subtree to release
+{
+	//the rotations of FreeTree, so no stack is needed and releasing a cut off range can not run out of memory
+
+	int released = 0;
+
+	while (trav != nullptr)
+	{
+		node* temp = trav->left;
+
+		if (temp != nullptr)
+		{
+			trav->left = temp->right;
+			temp->right = trav;
+			trav = temp;
+
+		}//end if
+
+		else
+		{
+			temp = trav->right;
+			ReleaseNode(trav);
+			++released;
+			trav = temp;
+
+		}//end else
+
+	}//end while
+
+	return released;
+
+}//end ReleaseTree
+
+
+/*****************************************************************************************************/
+
+//Pre: OrdListClass has been instantiated
+//Post: returns true to the caller if the list keeps a hash index, a filter or a payload arena
+bool OrdListClass::HasSideData() const
+{
+	return (hashIndex != nullptr || filter != nullptr || payloads != nullptr);
+
+}//end HasSideData
+
+
+/*****************************************************************************************************/
+
+//Pre: trav is the root of the tree of the current object, to is a different list
+//Post: moved holds every node of the tree with a key >= key (every node if whole), the nodes that are to move
+//		to to, and when the current list keeps payloads copies holds a copy of the payload of each in to's arena
+//		(NO_PAYLOAD for none). the index of to has room for them, and the filter of to if to is empty.
+//		nothing else has changed
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. the copies made so far
+//					 are released again
+void OrdListClass::CopyOut(	/*in*/node* trav,						//root of the tree
+							/*in*/KeyType key,						//smallest key that moves
+							/*in*/bool whole,						//true if every node moves
+							/*inout*/OrdListClass& to,				//list the nodes move to
+							/*out*/vector<node*>& moved,			//every node that moves
+							/*out*/vector<PayloadHandle>& copies) const	//their payloads in to's arena
+{
+	//everything that can fail is done here, before the tree is cut, so a failure leaves both lists as they
+	//were. arenas belong to one list each, so payload bytes are copied across. the nodes themselves stay put
+
+	vector<node*> pending;
+
+	try
+	{
+		if (trav != nullptr)
+		{
+			pending.push_back(trav);
+
+		}//end if
+
+		while (!pending.empty())
+		{
+			node* temp = pending.back();
+			bool moves = whole || !(temp->data.key < key);
+			pending.pop_back();
+
+			if (moves)
+			{
+				moved.push_back(temp);
+
+			}//end if
+
+			if (temp->left != nullptr && moves)
+			{
+				pending.push_back(temp->left);
+
+			}//end if
+
+			if (temp->right != nullptr)
+			{
+				pending.push_back(temp->right);
+
+			}//end if
+
+		}//end while
+
+		if (to.hashIndex != nullptr)
+		{
+			to.hashIndex->Reserve(to.length + (int)moved.size());
+
+		}//end if
+
+		if (to.filter != nullptr && to.length == 0)
+		{
+			to.filter->Reset((int)moved.size());		//so the moved keys are unlikely to force a rebuild
+
+		}//end if
+
+		if (payloads != nullptr)
+		{
+			copies.reserve(moved.size());
+			if (to.payloads == nullptr)
+			{
+				to.payloads = new PayloadArenaClass;
+
+			}//end if
+
+			for (size_t i = 0; i < moved.size(); ++i)
+			{
+				PayloadView bytes = payloads->View(moved[i]->payload);
+
+				copies.push_back((moved[i]->payload == NO_PAYLOAD) ? NO_PAYLOAD : to.payloads->Store(bytes.data, bytes.size));
+
+			}//end for
+
+		}//end if
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		for (size_t i = 0; i < copies.size(); ++i)
+		{
+			to.payloads->Release(copies[i]);
+
+		}//end for
+
+		moved.clear();
+		copies.clear();
+		throw OutOfMemoryException();
+
+	}//end catch
+
+}//end CopyOut
+
+
+/*****************************************************************************************************/
+
+//Pre: CopyOut made moved and copies, the nodes in moved are leaving the current object
+//Post: every node in moved has left the hash index and filter of the current object, and its payload has been
+//		released here and replaced by its copy. never throws
+void OrdListClass::MoveOut(	/*in*/const vector<node*>& moved,			//every node that moves
+							/*in*/const vector<PayloadHandle>& copies)	//their payloads in the new arena
+{
+	for (size_t i = 0; i < moved.size(); ++i)
+	{
+		node* temp = moved[i];
+
+		if (hashIndex != nullptr)
+		{
+			hashIndex->Erase(temp->data.key, temp);
+
+		}//end if
+
+		if (filter != nullptr)
+		{
+			filter->Erase(temp->data.key);
+
+		}//end if
+
+		if (payloads != nullptr)
+		{
+			payloads->Release(temp->payload);
+			temp->payload = copies[i];
+
+		}//end if
+
+	}//end for
+
+}//end MoveOut
+
+
+/*****************************************************************************************************/
+
+//Pre: the nodes in moved have been linked into the tree of the current object
+//Post: they have been entered in the hash index and the filter of the current object
+//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+void OrdListClass::MoveIn(/*in*/const vector<node*>& moved) //nodes that moved in
+{
+	if (hashIndex != nullptr)
+	{
+		try
+		{
+			hashIndex->Reserve(length);
+
+		}//end try
+
+		catch (bad_alloc&)
+		{
+			throw OutOfMemoryException();
+
+		}//end catch
+
+	}//end if
+
+	for (size_t i = 0; i < moved.size(); ++i)
+	{
+		IndexNode(moved[i]);
+
+	}//end for
+
+	//a full filter is rebuilt from the whole tree, which already holds every moved key
+	for (size_t i = 0; i < moved.size() && filter != nullptr; ++i)
+	{
+		if (!filter->Insert(moved[i]->data.key))
+		{
+			FilterTree(2 * length);
+			break;
+
+		}//end if
 
+	}//end for
 
+}//end MoveIn
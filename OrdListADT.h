@@ -16,13 +16,76 @@ Assumptions: All items are stored by a KeyType key. Currently the KeyType is set
 
 #include <iostream>
 #include <fstream>
+#include <memory>
+#include <vector>
 #include "ItemType.h"
+#include "PayloadArena.h"
 using namespace std;
 
 typedef void(*FunctionType)(const ItemType&);
 
 typedef void(*FunctionTypeFile)(const ItemType&, ofstream&);
 
+//value produced for every item by the parallel map functions
+typedef double MapType;
+
+typedef MapType(*MapFunctionType)(const ItemType&);
+
+typedef MapType(*ReduceFunctionType)(MapType, MapType);
+
+typedef void(*EmitFunctionType)(const ItemType&, MapType);
+
+//which item survives when a bulk load meets the same key more than once
+enum DuplicatePolicyType
+{
+	KEEP_FIRST,			//the item that came first in the input
+	KEEP_LAST,			//the item that came last in the input
+	DUPLICATE_ERROR		//a repeated key is an error
+};
+
+//how the list keeps its height in check
+enum BalanceModeType
+{
+	BALANCE_NONE,		//plain BST, the shape depends on the order of the inserts
+	BALANCE_SCAPEGOAT,	//subtrees that grow too deep are rebuilt balanced
+	BALANCE_SPLAY		//Find and Insert move the node they touch to the root
+};
+
+//Operation counters. Only updated when the list is compiled with ORDLIST_STATS defined, so that a normal
+//build pays nothing for them
+struct OpCounters
+{
+	long long findComparisons;		//nodes whose key was compared by rFind
+	long long nextPositionVisits;	//nodes stepped over by NextPosition, including the Finds it makes
+	long long allocations;			//nodes allocated one at a time by Allocate
+	long long blockAllocations;		//contiguous node blocks allocated by BuildFromSorted
+	long long deallocations;		//nodes returned by Deallocate
+	long long filterRejects;		//Finds the cuckoo filter answered without looking at the tree
+};
+
+//snapshot returned by OrdListClass::Stats
+struct ListStats
+{
+	OpCounters counters;				//operation counters since construction or ResetStats
+	bool countersEnabled;				//false if compiled without ORDLIST_STATS (counters are all 0)
+	int length;							//number of nodes
+	int height;							//number of levels, 0 for an empty list
+	double averageDepth;				//mean depth of a node, the root is at depth 0
+	vector<long long> depthHistogram;	//depthHistogram[d] is the number of nodes at depth d
+	long long indexBytes;				//bytes held by the hash index, 0 when it is off
+	long long filterBytes;				//bytes held by the cuckoo filter, 0 when it is off
+	long long payloadBytes;				//bytes held by the payload arena
+};
+
+//outcome of inserting one item
+enum InsertStatusType
+{
+	INSERTED,			//the item was added to the list
+	DUPLICATE_KEY,		//the key was already in the list, nothing was added
+	ASSIGNED,			//the key was already in the list, its item was overwritten (InsertOrAssign)
+	COUNTED				//the key was already in the list, its count went up (multiset mode)
+};
+
 // IMPORTANT: PLEASE NOTE:  THIS IS A CLASS TEMPLATE,  THEREFORE: 
 //				(1) THE STRUCT ItemType DECLARATION MUST BE SUPPLIED BY CLIENT AND 
 //						APPEAR ABOVE THE MAIN. 
@@ -33,6 +96,12 @@ typedef void(*FunctionTypeFile)(const ItemType&, ofstream&);
 // A forward declaration should be used and appears below 
 struct node;
 
+class ThreadPoolClass;
+
+class HashIndexClass;
+
+class CuckooFilterClass;
+
 /*
 
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -102,11 +171,12 @@ void PrintAsExists(FunctionType visit);
 	the current list has been printed to the console formatted like a tree
 
 virtual void operator=(const OrdListClass& rightOp);
-	current object is identical to rightOp
+	current object is identical to rightOp, multiset mode and counts included
 
 
 virtual bool operator==(const OrdListClass& rightOp) const
-	returns true to the caller if current objects keys are identical to rightOp, false otherwise
+	returns true to the caller if current objects keys (and the counts of a multiset) are identical to rightOp,
+	false otherwise
 
 
 virtual bool operator!=(const OrdListClass& rightOp) const;
@@ -118,6 +188,125 @@ OrdListClass operator+(const OrdListClass& rightOp) const;
 	an empty list was added to an unbalanced list, the returning list will be different even though nothing
 	was added to the list
 
+void SetThreadPool(ThreadPoolClass* pool);
+	the parallel functions of the current list run on pool. nullptr selects the shared default pool
+
+void ParallelForEach(FunctionType visit) const;
+	every item of the list has been visited once, in no particular order, by the threads of the pool
+
+MapType ParallelMapReduce(MapFunctionType map, ReduceFunctionType reduce, MapType identity) const;
+	returns the reduction of map over every item of the list to the caller
+
+void ParallelMap(MapFunctionType map, EmitFunctionType emit, bool ordered) const;
+	map has been applied to every item in parallel and each result handed to emit, in key order if ordered
+
+void BuildFromSorted(ItemType items[], int length, bool adopt);
+	the list holds exactly the length items of the sorted array items, as a balanced tree built in parallel
+
+void BulkLoad(const ItemType items[], int length, DuplicatePolicyType policy);
+	the list holds the items of the unsorted array items, duplicates resolved by policy, as a balanced tree
+
+int InsertBatch(const ItemType items[], int length, InsertStatusType status[]);
+	every new key of items has been inserted, status says which ones were. returns the number inserted
+
+ListStats Stats() const;
+	returns a snapshot of the operation counters and the shape of the tree to the caller
+
+void ResetStats();
+	every operation counter has been set back to zero
+
+void SetBalanceMode(BalanceModeType mode, double alpha);
+	sets how the list keeps its height in check as keys are inserted and deleted
+
+void Rebalance();
+	the tree has been reshaped in place into a complete balanced tree, O(N) time and O(1) extra memory
+
+bool FingerFind(KeyType key);
+	Find that starts from the last position found instead of the root, climbing only as far as needed
+
+void FindBatch(const KeyType keys[], int count, bool found[]) const;
+	found[i] is true if keys[i] is in the list. the searches advance in lockstep so their cache misses overlap
+
+void LowerBoundBatch(const KeyType keys[], int count, ItemType bounds[], bool hasBound[]) const;
+	bounds[i] is the item with the smallest key >= keys[i], hasBound[i] false if there is none
+
+void SetHashIndex(bool enabled, double loadFactor);
+	turns the hash side index on or off. with it on, Find answers from the index instead of descending the tree
+
+long long ReturnIndexBytes() const;
+	returns the number of bytes held by the hash index, 0 when it is off
+
+void SetFilter(bool enabled, double falsePositiveRate);
+	turns the cuckoo filter in front of Find on or off. with it on, most Finds for missing keys skip the tree
+
+long long ReturnFilterBytes() const;
+	returns the number of bytes held by the filter, 0 when it is off
+
+void SetPayload(const char* bytes, int size);
+	the item at currPos carries a copy of bytes as its payload, kept out of line in the payload arena
+
+PayloadView RetrievePayload() const;
+	returns a view of the payload of the item at currPos to the caller, without copying it
+
+InsertStatusType TryInsert(ItemType newItem);
+	newItem has been inserted unless its key is already in the list. one descent, never throws for a duplicate
+
+InsertStatusType InsertOrAssign(ItemType newItem);
+	newItem has been inserted, or has replaced the item with the same key. one descent, never throws for a duplicate
+
+bool Erase(KeyType key);
+	the item with key has been removed in one descent. returns false if there was none
+
+int EraseRange(KeyType low, KeyType high);
+	every item with a key in [low, high] has been removed by cutting the range out whole. returns how many
+
+void Split(KeyType key, OrdListClass& greater);
+	the items with keys >= key have been moved into greater by relinking nodes, the rest stay. O(H + min(k, N - k))
+
+void Join(OrdListClass& other);
+	every item of other has been moved into the current list by relinking nodes. the key ranges must not overlap
+
+bool Floor(KeyType key, ItemType& item) const;
+	item is the item with the largest key <= key. returns false if there is none. the list is not changed
+
+bool Ceiling(KeyType key, ItemType& item) const;
+	item is the item with the smallest key >= key. returns false if there is none. the list is not changed
+
+bool Predecessor(KeyType key, ItemType& item) const;
+	item is the item with the largest key < key. returns false if there is none. the list is not changed
+
+bool Successor(KeyType key, ItemType& item) const;
+	item is the item with the smallest key > key. returns false if there is none. the list is not changed
+
+void operator+=(const OrdListClass& rightOp);
+	the current list holds the union of its keys and rightOp's keys, reusing its own nodes
+
+void SetMultiset(bool enabled, bool expand);
+	a repeated key raises the count of its node instead of being rejected, Delete drops one copy at a time
+
+int Count(KeyType key) const;
+	returns the number of copies of key in the list to the caller, 0 if it is not there
+
+int RetrieveCount() const;
+	returns the number of copies of the item at currPos to the caller
+
+void DumpFile(string fileName) const;
+	the keys have been written to fileName one per line in preorder, the file PrintFile makes with a client
+	that writes key << endl, formatted into a large buffer instead of one stream call per key
+
+void LoadFile(string fileName);
+	the list holds the keys of fileName. the output of PrintFile or DumpFile is rebuilt into an identical tree
+	unless that tree is too deep, then the keys are loaded balanced
+
+void SaveCompressed(string fileName) const;
+	the keys have been written to fileName in order, as varint deltas in blocks that decode on their own
+
+void LoadCompressed(string fileName);
+	the list holds every key of the compressed file fileName, its blocks decoded in parallel
+
+void LoadCompressedRange(string fileName, KeyType low, KeyType high);
+	the list holds the keys of fileName in [low, high]. only the blocks that can hold them are read
+
 ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 ~                                            ~
 ~              Protected Methods			 ~
@@ -134,7 +323,7 @@ void rDelete(node *&trav);
 	given a node pointer, delete the current node maintaining proper order
 	when prevPos is a nullptr, currPos is pointing to the root
 
-void rPreOrderTrav(node *rtRoot);
+void rPreOrderTrav(node *rtRoot, const PayloadArenaClass* from);
 	does a pre-order traversal of rtRoot and inserts them into the current object
 
 void CreateTree(ItemType items[], OrdListClass& list, int start, int end) const;
@@ -151,6 +340,81 @@ void rBackwardInOrderTrav(FunctionType visit, node* trav);
 
 bool rFind(KeyType key);
 	returns true to the caller if key is found in the current object, false otherwise. wrapped function
+
+ThreadPoolClass* ReturnPool() const;
+	returns the pool the parallel functions run on
+
+void Deallocate(node* trav);
+	returns trav to the freestore, unless it was carved from a block
+
+void OwnBlock(node* block);
+	the list owns block, freed once every list holding its nodes has been cleared
+
+void FreeTree(node* trav);
+	every node of the subtree at trav has been deallocated
+
+void InsertMidpoints(const ItemType items[], const int order[], int start, int end, InsertStatusType status[]);
+	inserts the items of a sorted range midpoint first, so that a run of sorted keys does not grow a chain
+
+void ScapegoatInsert(KeyType key);
+	if the node just inserted for key is too deep, the subtree of its scapegoat ancestor has been rebuilt
+
+node* RebuildSubtree(node* trav);
+	relinks the nodes of the subtree at trav into a perfectly balanced subtree and returns its root
+
+void Compress(node* pseudoRoot, int count);
+	one Day-Stout-Warren compression pass: count left rotations down the right spine of pseudoRoot
+
+bool Locate(KeyType key);
+	Find without any restructuring. currPos is set to the node for key or where it would go, prevPos to its parent
+
+void Splay(KeyType key);
+	top-down splay: the node for key, or the last node on its search path, is now the root
+
+void FingerPush(node* trav);
+	trav has been pushed on the finger path below its parent, with the key range of its subtree
+
+void SettleCursor();
+	prevPos has been set to the parent of currPos if a Find answered from the hash index left it unset
+
+void IndexTree();
+	every node of the tree has been entered in the hash index
+
+void IndexNode(node* trav);
+	trav has been entered in the hash index, if there is one
+
+void FilterKey(KeyType key);
+	key has been added to the filter, if there is one. the filter is rebuilt larger when it is full
+
+void FilterTree(int capacity);
+	the filter holds exactly the keys of the tree and has room for capacity keys
+
+InsertStatusType Upsert(ItemType newItem, bool assign);
+	shared body of TryInsert and InsertOrAssign
+
+void ReleaseNode(node* trav);
+	trav has left the index, filter and payload arena, been deallocated and uncounted
+
+int ReleaseTree(node* trav);
+	ReleaseNode has been applied to every node of the unlinked subtree at trav. returns how many
+
+bool HasSideData() const;
+	returns true if the list keeps a hash index, a filter or payloads
+
+void CopyOut(node* trav, KeyType key, bool whole, OrdListClass& to, vector<node*>& moved, vector<PayloadHandle>& copies) const;
+	the nodes that move to to have been collected and their payloads copied into to's arena, nothing changed yet
+
+void MoveOut(const vector<node*>& moved, const vector<PayloadHandle>& copies);
+	the nodes in moved have left the index and filter, their payloads have been swapped for the copies
+
+void MoveIn(const vector<node*>& moved);
+	the nodes in moved, now linked into the tree, have been entered in the index and filter
+
+void PrepareLoad(OrdListClass& loaded) const;
+	loaded uses the pool, multiset mode, hash index and filter settings of the current list
+
+void FinishLoad(OrdListClass& loaded);
+	the tree built in loaded has been swapped into the current list
 */
 
 class OrdListClass
@@ -204,7 +468,8 @@ public:
 	/*****************************************************************************************************/
 
 	//Pre: OrdListClass has been instantiated
-	//Post: sets the current position of the list to the next greatest element in the list
+	//Post: sets the current position of the list to the next greatest element in the list. with expanded multiset
+	//		iteration on, every copy of a key is a position of its own (Retrieve returns the same item for each)
 	void  NextPosition();	
 
 	/*****************************************************************************************************/
@@ -231,16 +496,18 @@ public:
 	/*****************************************************************************************************/
 
 	//Pre: OrdListClass has been instantiated , Find has been called to set currPos
-	//Post: newItem is inserted into the correct position in the list
+	//Post: newItem is inserted into the correct position in the list. in multiset mode a key that is already
+	//		in the list has its count raised instead, and currPos is left on it
 	//Exceptions thrown: throws a DuplicateKeyException if the caller attempts to insert a item that 
-	//					 is already in the list
+	//					 is already in the list (unless the list is a multiset)
 	bool Insert(/*in*/ItemType newItem); //item to insert into the list
 
 	/*****************************************************************************************************/
 
 	//Pre: OrdListClass has been instantiated, Find has been called to set currPos to the element that needs
 	//		to be deleted
-	//Post: the element at currPos has been removed from the list
+	//Post: the element at currPos has been removed from the list. in multiset mode (or while the item
+	//		still has copies) one copy is dropped, and the node only goes with the last one
 	void Delete();	
 
 	/*****************************************************************************************************/
@@ -284,13 +551,14 @@ public:
 	/*****************************************************************************************************/
 
 	//Pre: OrdListClass has been instantiated, rightOp is a valid OrdListClass
-	//Post: current object is identical to rightOp
+	//Post: current object is identical to rightOp, multiset mode and counts included
 	virtual void operator=(/*in*/const OrdListClass& rightOp); //object to be copied
 
 	/*****************************************************************************************************/
 
 	//Pre: OrdListClass has been instantiated, rightOp is a valid OrdListClass
-	//Post: returns true to the caller if current objects keys are identical to rightOp, false otherwise
+	//Post: returns true to the caller if current objects keys (and the counts of a multiset) are identical to
+	//		rightOp, false otherwise
 	virtual bool operator==(/*in*/const OrdListClass& rightOp) const; //object to compare to
 
 	/*****************************************************************************************************/
@@ -305,11 +573,424 @@ public:
 	//Post: returns a new OrdListClass with the union of the current objects keys and rightOp's keys. The new
 	//		list is a near balanced/complete tree. Since the function creates a new object, and balances it, if 
 	//		an empty list was added to an unbalanced list, the returning list will be different even though nothing
-	//		was added to the list
+	//		was added to the list. if either list is a multiset the result is one, and counts of shared keys add up
 	OrdListClass operator+(/*in*/const OrdListClass& rightOp) const; //object to union
 
 	/*****************************************************************************************************/
 
+	//Pre: OrdListClass has been instantiated, pool is nullptr or outlives the list
+	//Post: the parallel functions of the current list run on pool. nullptr selects the shared default pool.
+	//		one pool may be shared by any number of lists
+	void SetThreadPool(/*in*/ThreadPoolClass* pool); //pool to run on
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, visit is a valid FunctionType that is safe to call from several
+	//		threads at once
+	//Post: every item of the list has been visited once, in no particular order, by the threads of the pool.
+	//		subtrees are handed to idle workers as they become hungry, so the work stays balanced
+	void ParallelForEach(/*in*/FunctionType visit) const; //function pointer. passes control back to client
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, map is safe to call from several threads at once, reduce is
+	//		associative and commutative and identity is its identity value
+	//Post: returns the reduction of map over every item of the list to the caller. identity if the list is empty
+	MapType ParallelMapReduce(	/*in*/MapFunctionType map,			//value computed for each item
+								/*in*/ReduceFunctionType reduce,	//combines two values
+								/*in*/MapType identity) const;		//value of an empty reduction
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, map is safe to call from several threads at once. emit is safe
+	//		to call from several threads at once unless ordered is true
+	//Post: map has been applied to every item in parallel and each item and its result handed to emit. When
+	//		ordered is true emit is called from the calling thread in key order, otherwise as results are ready
+	void ParallelMap(	/*in*/MapFunctionType map,		//value computed for each item
+						/*in*/EmitFunctionType emit,	//receives each item and its value
+						/*in*/bool ordered) const;		//true to emit in key order
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, items holds length items sorted by strictly increasing key
+	//		(non-decreasing in multiset mode). if adopt is true items was allocated with new[]
+	//Post: the list holds exactly the length items of items, as a balanced tree. The nodes are carved from one
+	//		contiguous block and the two halves of every range are built in parallel on the pool. A multiset makes
+	//		one node of every run of equal keys, the first item of the run, counted once per item as InsertBatch
+	//		counts. If adopt is true the list has taken ownership of items and released it, the caller must not use
+	//		it again
+	//Exceptions thrown: throws a DuplicateKeyException if items is not strictly increasing, or not non-decreasing
+	//					 for a multiset (the list is left empty)
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	void BuildFromSorted(	/*in*/ItemType items[],	//sorted items
+							/*in*/int length,		//number of items
+							/*in*/bool adopt);		//true to hand items over to the list
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, items holds length items in any order
+	//Post: the list holds the items of items as a balanced tree. items is sorted by a parallel stable merge sort
+	//		on the pool, then every run of equal keys is reduced to one item as policy says: KEEP_FIRST keeps the
+	//		item that came first in items, KEEP_LAST the one that came last. A multiset counts every item of the
+	//		run instead of dropping it (DUPLICATE_ERROR then keeps the first). items itself is not changed
+	//Exceptions thrown: throws a DuplicateKeyException under DUPLICATE_ERROR if a key repeats outside multiset mode
+	//					 (the list is not changed)
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	void BulkLoad(	/*in*/const ItemType items[],			//unsorted items
+					/*in*/int length,						//number of items
+					/*in*/DuplicatePolicyType policy);		//which of several equal keys survives
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, items holds length items in any order, status has room for length
+	//		entries
+	//Post: every key of items that was not already in the list has been inserted. status[i] is INSERTED if
+	//		items[i] was added and DUPLICATE_KEY if its key was already in the list or appeared earlier in items
+	//		(COUNTED in multiset mode, where every such item raises the count of its key).
+	//		The batch is sorted once, then either inserted key by key (midpoint first, small batches) or merged
+	//		with the whole list and rebuilt balanced (large batches), whichever touches fewer nodes.
+	//		returns the number of items inserted to the caller
+	//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap
+	int InsertBatch(/*in*/const ItemType items[],			//items to insert
+					/*in*/int length,						//number of items
+					/*out*/InsertStatusType status[]);		//outcome for each item
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: returns a snapshot of the operation counters and the shape of the tree to the caller. The shape
+	//		(length, height, average depth, depth histogram) is measured by walking the tree, O(N). The counters
+	//		are only kept when compiled with ORDLIST_STATS, otherwise they read 0 and countersEnabled is false
+	ListStats Stats() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: every operation counter has been set back to zero
+	void ResetStats();
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated. for BALANCE_SCAPEGOAT 0.5 < alpha < 1 (0.7 is a good default)
+	//Post: sets how the list keeps its height in check. BALANCE_NONE is the plain BST. BALANCE_SCAPEGOAT checks
+	//		the depth of every inserted node: past log(N) / log(1 / alpha) (about 1.94 * log2(N) for 0.7) the
+	//		deepest ancestor whose child holds more than alpha of its nodes is rebuilt into a perfectly balanced
+	//		subtree, the same midpoint split CreateTree uses, reusing the nodes in place. Once deletes shrink the
+	//		list below alpha of its largest size since the last full rebuild, the whole tree is rebuilt. This gives
+	//		amortized O(log N) updates with no extra data in the nodes. BALANCE_SPLAY makes Find splay the node it
+	//		lands on (the key, or its neighbour on a miss) to the root and Insert add the new node as the root,
+	//		so hot and freshly inserted keys are a few hops away, amortized O(log N). Retrieve and Delete after
+	//		Find work as before, the cursor functions never splay. Switching modes does not reshape the tree
+	void SetBalanceMode(/*in*/BalanceModeType mode,	//balancing strategy
+						/*in*/double alpha);		//scapegoat weight balance factor
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: the tree has been reshaped into a complete balanced tree (height floor(log2 N) + 1) using the
+	//		Day-Stout-Warren algorithm: right rotations straighten the tree into a sorted vine, then rounds of left
+	//		rotations fold the vine back into a tree. O(N) time, O(1) extra memory, no node is allocated or freed
+	//		and no item is copied. currPos is left at the root
+	void Rebalance();
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key is a valid KeyType
+	//Post: same result and cursor as Find. The search starts from the path to the position the previous
+	//		FingerFind (or Insert after it) left behind: it climbs only until key falls inside the key range of a
+	//		subtree on that path, then descends from there. A sorted run of probes therefore costs about the
+	//		distance between neighbouring keys, O(log d) amortized, instead of a full descent each. Any other change
+	//		to the tree drops the path and the next FingerFind starts from the root. In splay mode it is Find
+	bool FingerFind(/*in*/KeyType key); //key to find
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, keys holds count keys, found has room for count entries
+	//Post: found[i] is true if keys[i] is in the list, false otherwise. Groups of searches advance one level at
+	//		a time in lockstep and prefetch the node each one visits next, so the cache misses of different keys
+	//		overlap instead of queueing behind each other. the list (cursor included) is not changed
+	void FindBatch(	/*in*/const KeyType keys[],	//keys to look up
+					/*in*/int count,				//number of keys
+					/*out*/bool found[]) const;		//result for each key
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, keys holds count keys, bounds and hasBound have room for count entries
+	//Post: bounds[i] is the item with the smallest key that is not less than keys[i] and hasBound[i] is true, or
+	//		hasBound[i] is false if every key in the list is less than keys[i]. Searched in lockstep groups as in
+	//		FindBatch. the list (cursor included) is not changed
+	void LowerBoundBatch(	/*in*/const KeyType keys[],		//keys to look up
+							/*in*/int count,				//number of keys
+							/*out*/ItemType bounds[],		//lower bound of each key
+							/*out*/bool hasBound[]) const;	//false where there is no lower bound
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, 0 < loadFactor < 1 (0.5 is a good default)
+	//Post: enabled builds a hash index from key to node next to the tree, !enabled drops it. The index fills at
+	//		most loadFactor of its slots, so each key costs at least 16 / loadFactor bytes on a 64 bit build (32
+	//		at 0.5), up to twice that right after the table doubles. While it is on, Find looks the key up in
+	//		the index and leaves the tree alone (no splaying either), so Find followed by Retrieve never walks
+	//		the tree. Ordered functions still use the tree. Insert and Delete after such a Find descend once to
+	//		find the parent
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void SetHashIndex(	/*in*/bool enabled,			//true to keep an index
+						/*in*/double loadFactor);	//largest fraction of index slots in use
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: returns the number of bytes held by the hash index, 0 when it is off
+	long long ReturnIndexBytes() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, 0 < falsePositiveRate < 1 (0.01 is a good default)
+	//Post: enabled puts a cuckoo filter in front of Find, !enabled drops it. Find first asks the filter and
+	//		returns false at once (no tree walk, no splaying) when the filter is sure the key is missing. Of the
+	//		Finds for missing keys at most about falsePositiveRate still walk the tree. Fingerprints take 4 to 16
+	//		bits (rate ~ 8 / 2^bits, so 0.01 gets 10 bits, 0.0002 gets 16), stored in 16 bit slots at most 90%
+	//		full: 2.2 to 8 bytes per key. Insert and Delete keep the filter exact, BuildFromSorted (and so
+	//		BulkLoad, InsertBatch and operator+) rebuilds it in one pass over the loaded tree. Insert and Delete
+	//		after a rejected Find descend once to find the parent
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void SetFilter(	/*in*/bool enabled,					//true to keep a filter
+					/*in*/double falsePositiveRate);	//largest share of misses that walk the tree
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: returns the number of bytes held by the filter, 0 when it is off
+	long long ReturnFilterBytes() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, currPos is on an item (Find returned true, or Insert was just
+	//		called), bytes holds size bytes
+	//Post: the item at currPos carries a copy of bytes as its payload, replacing any payload it had. Payloads
+	//		live in an arena beside the tree and a node only keeps a 4 byte handle to its payload, so Find and
+	//		the other descents touch the same small nodes however large the payloads are. Copies of the list
+	//		(copy constructor, operator=, operator+) copy the payloads, BuildFromSorted makes items without one
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void SetPayload(/*in*/const char* bytes,	//payload to copy
+					/*in*/int size);			//number of bytes
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, currPos is on an item
+	//Post: returns a view of the payload of the item at currPos to the caller, { nullptr, 0 } if it has none.
+	//		nothing is copied: the view stays valid until that item's payload is set again, the item is
+	//		deleted, or the list is cleared or reloaded
+	//Exceptions thrown: throws a RetrieveOnEmptyException if the list is empty
+	PayloadView RetrievePayload() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated. no Find is needed first
+	//Post: if the key of newItem is not in the list, newItem has been inserted and INSERTED is returned.
+	//		otherwise nothing changes and DUPLICATE_KEY is returned (a multiset raises its count and returns
+	//		COUNTED). either way currPos is left on the item with that key, so Retrieve, RetrievePayload and
+	//		SetPayload apply to it. The search for the key is also the search for the parent, so the tree is
+	//		descended once (with the hash index on, a duplicate costs one probe). Balance modes, index and
+	//		filter are kept up to date as by Insert
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	InsertStatusType TryInsert(/*in*/ItemType newItem); //item to insert
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated. no Find is needed first
+	//Post: if the key of newItem is not in the list, newItem has been inserted and INSERTED is returned.
+	//		otherwise the item with that key has been overwritten by newItem (its payload is kept) and ASSIGNED
+	//		is returned. currPos is left on the item, the tree is descended once, as in TryInsert
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	InsertStatusType InsertOrAssign(/*in*/ItemType newItem); //item to insert or assign
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated. no Find is needed first
+	//Post: if key is in the list its item (and payload) has been removed and true returned, false otherwise.
+	//		One descent: a node with two children is replaced by relinking its successor in its place, rather
+	//		than copying the successor's item and searching for it again as Delete does. With the filter on, a
+	//		key the filter rules out returns at once. currPos is left on the root
+	bool Erase(/*in*/KeyType key); //key to remove
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: every item with low <= key <= high has been removed and their number returned (0 if low > high).
+	//		The tree is cut at low and at high by relinking the two search paths, so the range comes out as one
+	//		subtree that is freed in a single walk without allocating, and what is left either side is joined
+	//		back under one node. The cut is O(H + k) for k removed items. When anything was removed the tree
+	//		is then rebalanced once (O(N), no allocation) in every mode, so a large range leaves a complete
+	//		tree behind rather than the joined pieces. currPos is left on the root
+	int EraseRange(	/*in*/KeyType low,		//smallest key to remove
+					/*in*/KeyType high);	//largest key to remove
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, greater is a different list
+	//Post: greater holds the items with keys >= key (whatever it held before is cleared) and the current list
+	//		the items with smaller keys. The tree is cut along the search path of key, so no node is copied or
+	//		allocated and both pieces are no taller than the tree was. Nodes carry no subtree sizes, so this is not
+	//		O(log N): the lengths are found by counting the smaller piece, O(H + min(k, N - k)) for k moved items.
+	//		When either list keeps a hash index, a filter or payloads, the entries of the k moved items move too,
+	//		O(H + k). Each list keeps its own balance mode. in scapegoat mode a piece keeps the size epoch of the
+	//		tree and, like a Delete, is rebuilt in O(piece) once it holds less than alpha of that size (always if
+	//		the tree was not bounded by the same alpha). both cursors are left on the roots
+	//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap. every
+	//					 allocation comes before the tree is cut, so the current list is not changed (greater may
+	//					 have been cleared). only when the filter of greater has to be rebuilt after the move and
+	//					 runs out of memory is the split complete, and greater left without a filter
+	void Split(	/*in*/KeyType key,				//smallest key to move
+				/*inout*/OrdListClass& greater);	//receives the items with keys >= key
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, other is a different list, every key of other is greater than
+	//		every key of the current list, or every key of other is smaller
+	//Post: every item of other has been moved into the current list and other is empty. The largest node of the
+	//		lower tree is lifted to become the root over both trees, so no node is copied or allocated and the
+	//		tree is at most one level taller than the taller of the two. O(H), plus O(size of other) when
+	//		either list keeps a hash index, a filter or payloads. the cursors are left on the roots
+	//Exceptions thrown: throws a KeyRangeOverlapException if the key ranges overlap. neither list is changed
+	//					 throws an OutOfMemoryException when there is no more space left on the heap. neither list
+	//					 is changed, unless the filter of the current list has to be rebuilt after the move and
+	//					 runs out of memory: then the join is complete and the list left without a filter
+	void Join(/*inout*/OrdListClass& other); //list to move in
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key need not be in the list
+	//Post: returns true to the caller and sets item to the item with the largest key <= key, false if every key
+	//		is greater. One descent that only reads the tree: the cursor is not moved and the tree is not
+	//		splayed, so any number of threads may query a list nobody is changing
+	bool Floor(	/*in*/KeyType key,					//key to look around
+				/*out*/ItemType& item) const;		//item found
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key need not be in the list
+	//Post: returns true to the caller and sets item to the item with the smallest key >= key, false if every
+	//		key is smaller. reads only, as Floor
+	bool Ceiling(	/*in*/KeyType key,				//key to look around
+					/*out*/ItemType& item) const;	//item found
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key need not be in the list
+	//Post: returns true to the caller and sets item to the item with the largest key < key, false if there is
+	//		none. reads only, as Floor
+	bool Predecessor(	/*in*/KeyType key,				//key to look around
+						/*out*/ItemType& item) const;	//item found
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key need not be in the list
+	//Post: returns true to the caller and sets item to the item with the smallest key > key, false if there is
+	//		none. reads only, as Floor
+	bool Successor(	/*in*/KeyType key,				//key to look around
+					/*out*/ItemType& item) const;	//item found
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, rightOp is a valid OrdListClass
+	//Post: the current list holds the union of its keys and rightOp's keys. where both have a key the current
+	//		item (and payload) is kept as in operator+, and a multiset adds up the counts. A small rightOp
+	//		(m * log2(N) < N) is inserted key by key, so the tree keeps its shape and balance mode. Otherwise
+	//		both trees are merged in one in order pass and the current nodes plus one new node per new key are
+	//		relinked into a balanced tree: no item array and no second tree, the extra memory is one pointer per
+	//		node. rightOp is not changed and the cursor is left on the root
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. after a merge the
+	//		list is then unchanged
+	void operator+=(/*in*/const OrdListClass& rightOp); //object to union into the current list
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: enabled turns multiset mode on: Insert, TryInsert and InsertBatch of a key that is already in the
+	//		list raise the count kept in its node instead of rejecting it, so a repeat allocates nothing, and
+	//		Delete drops one copy at a time. Erase and EraseRange remove every copy, operator+ and operator+=
+	//		add the counts of keys both lists hold, BulkLoad and BuildFromSorted make one node of every run of
+	//		equal keys, counted once per item. expand makes NextPosition visit every copy of a key. Turning the
+	//		mode off sets every count back to 1
+	void SetMultiset(	/*in*/bool enabled,		//true for a multiset
+						/*in*/bool expand);		//true to iterate over every copy
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: returns the number of copies of key in the list to the caller, 0 if it is not there (always 0 or 1
+	//		outside multiset mode). reads only, as Floor
+	int Count(/*in*/KeyType key) const; //key to count
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, currPos is on an item
+	//Post: returns the number of copies of the item at currPos to the caller
+	//Exceptions thrown: throws a RetrieveOnEmptyException if the list is empty
+	int RetrieveCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: the keys have been written to fileName one per line in preorder, so that LoadFile (or reading it back
+	//		with Insert) makes an identical tree. The same file PrintFile makes with a client that writes
+	//		key << endl, but the keys are formatted with to_chars into one large buffer that is written whole
+	//		when full, and the stream is never flushed per key. counts and payloads are not written
+	//Exceptions thrown: throws a FileException if fileName can not be opened or written
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	void DumpFile(/*in*/string fileName) const; //file to write
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, fileName holds whitespace separated keys
+	//Post: the list holds the keys of fileName. The file is read whole, cut into slices at whitespace and the
+	//		slices parsed with from_chars in parallel on the pool. If the keys are a preorder (the output of
+	//		PrintFile or DumpFile) the tree they describe is rebuilt in one O(N) pass into a contiguous block of
+	//		nodes, the same tree reading the file back with Insert makes. Any other order of keys, and a preorder
+	//		whose tree is more than 2 * log2(N) + 2 deep (a sorted file is the preorder of a chain), is loaded as
+	//		a balanced tree by BulkLoad
+	//Exceptions thrown: throws a FileException if fileName can not be read or holds something that is not a key
+	//					 throws a DuplicateKeyException if a key repeats
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	//					 the list is not changed when an exception is thrown
+	void LoadFile(/*in*/string fileName); //file to read
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: the keys have been written to fileName in order in the compressed format. Keys go in blocks of
+	//		COMPRESSED_BLOCK, each one the varint encoded gaps between its keys, so dense increasing keys take
+	//		one or two bytes each. An index at the end of the file holds the first key, the number of keys and
+	//		the offset of every block, so any block decodes on its own. counts and payloads are not written
+	//Exceptions thrown: throws a FileException if fileName can not be opened or written
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	void SaveCompressed(/*in*/string fileName) const; //file to write
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: the list holds every key of the compressed file fileName as a balanced tree, see LoadCompressedRange
+	//Exceptions thrown: throws a FileException if fileName can not be read or is not a compressed file
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	//					 the list is not changed when an exception is thrown
+	void LoadCompressed(/*in*/string fileName); //file to read
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, fileName was written by SaveCompressed
+	//Post: the list holds the keys of fileName in [low, high] as a balanced tree built by BuildFromSorted.
+	//		Only the trailer, the index and the blocks whose key range meets [low, high] are read, in one
+	//		read each, and the blocks are decoded in parallel on the pool
+	//Exceptions thrown: throws a FileException if fileName can not be read or is not a compressed file
+	//					 throws an OutOfMemoryException when there is no more space left on the heap
+	//					 the list is not changed when an exception is thrown
+	void LoadCompressedRange(	/*in*/string fileName,		//file to read
+								/*in*/KeyType low,			//smallest key to load
+								/*in*/KeyType high);		//largest key to load
+
+	/*****************************************************************************************************/
+
 protected:
 
 	/*****************************************************************************************************/
@@ -338,8 +1019,10 @@ protected:
 	/*****************************************************************************************************/
 
 	//Pre: rtRoot is a valid root of a tree, OrdListClass has been instantiated
-	//Post: does a pre-order traversal of rtRoot and inserts them into the current object
-	void rPreOrderTrav(/*in*/node *rtRoot); //root of tree to copy
+	//Post: does a pre-order traversal of rtRoot and inserts them into the current object, with copies of their
+	//		payloads from the arena from (may be nullptr) and their counts
+	void rPreOrderTrav(	/*in*/node *rtRoot,						//root of tree to copy
+						/*in*/const PayloadArenaClass* from);	//arena the payloads of rtRoot's tree are in
 
 	/*****************************************************************************************************/
 
@@ -383,6 +1066,197 @@ protected:
 
 	/*****************************************************************************************************/
 
+	//Pre: OrdListClass has been instantiated
+	//Post: returns the pool the parallel functions run on
+	ThreadPoolClass* ReturnPool() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is a node of the current object that has been unlinked from the tree
+	//Post: returns trav to the freestore. a node carved from a block is left to the block, which goes when the
+	//		list that owns it is cleared
+	void Deallocate(/*in*/node* trav); //node to release
+
+	/*****************************************************************************************************/
+
+	//Pre: block was allocated with new[] and every node of it is tagged inBlock
+	//Post: the list owns block. it is freed once the list, and every list its nodes have moved to, has been cleared
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. block has been freed then
+	void OwnBlock(/*in*/node* block); //first node of the block
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is the root of a subtree that has been unlinked from the tree (or is the whole tree)
+	//Post: every node of the subtree at trav has been deallocated
+	void FreeTree(/*in*/node* trav); //root of the subtree to free
+
+	/*****************************************************************************************************/
+
+	//Pre: order[start..end] are indexes into items of distinct keys, sorted by key, that are not in the list
+	//Post: those items have been inserted, the midpoint of the range first, and their status set to INSERTED
+	void InsertMidpoints(	/*in*/const ItemType items[],		//batch being inserted
+							/*in*/const int order[],			//indexes of items in key order
+							/*in*/int start,					//starting index into order
+							/*in*/int end,						//ending index into order
+							/*out*/InsertStatusType status[]);	//outcome for each item
+
+	/*****************************************************************************************************/
+
+	//Pre: the node for key has just been linked into the tree, balanceMode is BALANCE_SCAPEGOAT
+	//Post: if the node is deeper than log(N) / log(1 / alpha), the subtree of its scapegoat ancestor has been
+	//		rebuilt balanced. currPos and prevPos are left on the node for key. the path is kept in insertPath, so
+	//		once it has grown to the height of the tree an insert allocates nothing here. if the rebuild runs out
+	//		of memory the tree is left as it was, a later insert finds the scapegoat again
+	void ScapegoatInsert(/*in*/KeyType key); //key just inserted
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is the root of a subtree of the current object (may be null)
+	//Post: relinks the nodes of the subtree at trav into a perfectly balanced subtree and returns its root to the
+	//		caller. no node is allocated or freed and no item is copied. the caller links the new root in place
+	//		of trav
+	node* RebuildSubtree(/*in*/node* trav); //root of the subtree to rebuild
+
+	/*****************************************************************************************************/
+
+	//Pre: pseudoRoot->right is a vine (or partly folded vine) with at least 2 * count nodes on its right spine
+	//Post: one Day-Stout-Warren compression pass: every other node of the first 2 * count nodes of the right
+	//		spine has been rotated left under its successor
+	void Compress(	/*inout*/node* pseudoRoot,	//node above the real root
+					/*in*/int count);			//rotations to make
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key is a valid KeyType
+	//Post: returns true to the caller if the key was found, false otherwise. currPos is either set to the found
+	//		node or where the node would appear in the list, prevPos to its parent. Never reshapes the tree, so
+	//		the cursor functions use it instead of Find
+	bool Locate(/*in*/KeyType key); //key to find
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key is a valid KeyType
+	//Post: top-down splay (Sleator and Tarjan): the node for key, or the last node on its search path, has been
+	//		rotated up to the root. if key is not in the list, every key in root's left subtree is smaller than key
+	//		and every key in its right subtree is greater
+	void Splay(/*in*/KeyType key); //key to splay
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is a child of the node on top of finger (or the root when finger is empty)
+	//Post: trav has been pushed on the finger path, with the key range its subtree is known to lie in
+	void FingerPush(/*in*/node* trav); //node the search has just moved to
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: if a Find answered from the hash index, prevPos has been set to the parent of currPos (or of where
+	//		the key would go). Called by every function that relies on prevPos
+	void SettleCursor();
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, hashIndex is not nullptr
+	//Post: the hash index holds exactly the nodes of the tree
+	void IndexTree();
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, trav is a node of the tree, the index has room for it (Reserve)
+	//Post: trav has been entered in the hash index under its key, if there is an index
+	void IndexNode(/*in*/node* trav); //node to enter
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, key has just been linked into the tree
+	//Post: key has been added to the filter, if there is one. a full filter is rebuilt from the tree with room
+	//		for twice the keys
+	//Exceptions thrown: throws an OutOfMemoryException if the rebuild runs out of memory. the filter is dropped
+	void FilterKey(/*in*/KeyType key); //key just inserted
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, filter is not nullptr
+	//Post: the filter holds exactly the keys of the tree and has room for capacity keys
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. the filter is dropped
+	void FilterTree(/*in*/int capacity); //number of keys to size the filter for
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: TryInsert (assign is false) or InsertOrAssign (assign is true) has been carried out and its status
+	//		returned to the caller
+	InsertStatusType Upsert(	/*in*/ItemType newItem,	//item to insert
+								/*in*/bool assign);		//true to overwrite an item with the same key
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is a node of the current object that has been unlinked from the tree
+	//Post: trav's key has left the hash index and the filter, its payload has been released, and trav has been
+	//		deallocated and taken off length
+	void ReleaseNode(/*in*/node* trav); //node to release
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is the root of a subtree of the current object that has been unlinked from the tree
+	//Post: ReleaseNode has been applied to every node of the subtree. returns how many to the caller
+	int ReleaseTree(/*in*/node* trav); //root of the subtree to release
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated
+	//Post: returns true to the caller if the list keeps a hash index, a filter or a payload arena
+	bool HasSideData() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: trav is the root of the tree of the current object, to is a different list
+	//Post: moved holds every node of the tree with a key >= key (every node if whole), the nodes that are to move
+	//		to to, and when the current list keeps payloads copies holds a copy of the payload of each in to's arena
+	//		(NO_PAYLOAD for none). the index of to has room for them, and the filter of to if to is empty.
+	//		nothing else has changed
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory. the copies made so far
+	//					 are released again
+	void CopyOut(	/*in*/node* trav,						//root of the tree
+					/*in*/KeyType key,						//smallest key that moves
+					/*in*/bool whole,						//true if every node moves
+					/*inout*/OrdListClass& to,				//list the nodes move to
+					/*out*/vector<node*>& moved,			//every node that moves
+					/*out*/vector<PayloadHandle>& copies) const;	//their payloads in to's arena
+
+	/*****************************************************************************************************/
+
+	//Pre: CopyOut made moved and copies, the nodes in moved are leaving the current object
+	//Post: every node in moved has left the hash index and filter of the current object, and its payload has been
+	//		released here and replaced by its copy. never throws
+	void MoveOut(	/*in*/const vector<node*>& moved,			//every node that moves
+					/*in*/const vector<PayloadHandle>& copies);	//their payloads in the new arena
+
+	/*****************************************************************************************************/
+
+	//Pre: the nodes in moved have been linked into the tree of the current object
+	//Post: they have been entered in the hash index and the filter of the current object
+	//Exceptions thrown: throws an OutOfMemoryException if the freestore is out of memory
+	void MoveIn(/*in*/const vector<node*>& moved); //nodes that moved in
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, loaded is a new empty list
+	//Post: loaded runs on the same pool as the current list, in the same multiset mode, and keeps a hash index and
+	//		a filter like it does, ready for a file to be loaded into it
+	//Exceptions thrown: throws an OutOfMemoryException when there is no more space left on the heap
+	void PrepareLoad(/*inout*/OrdListClass& loaded) const; //list the file is loaded into
+
+	/*****************************************************************************************************/
+
+	//Pre: OrdListClass has been instantiated, PrepareLoad has been applied to loaded and a tree built in it
+	//Post: the current list holds the tree of loaded, with its index, filter and blocks, and the cursor on the
+	//		root. loaded holds the old tree, and frees it when it goes. nothing here can fail
+	void FinishLoad(/*inout*/OrdListClass& loaded); //list the file was loaded into
+
+	/*****************************************************************************************************/
+
+
 
 private:
 
@@ -390,5 +1264,37 @@ private:
 	node* root;			//root node
 	node* currPos;		//current position in the list
 	node* prevPos;		//not nes. the preceeding node, but always the parent of currPos. nullptr when currPos == root
-
+	ThreadPoolClass* pool;	//pool used by the parallel functions. nullptr for the shared default pool
+	int length;			//number of nodes in the tree
+	OpCounters counters;	//operation counters (ORDLIST_STATS only)
+	BalanceModeType balanceMode;	//how the height is kept in check
+	double alpha;		//scapegoat weight balance factor
+	int maxLength;		//largest length since the last full rebuild (scapegoat)
+
+	//one step of the path FingerFind keeps: a node and the open key range its subtree lies in
+	struct FingerEntry
+	{
+		node* trav;
+		KeyType low;
+		KeyType high;
+		bool hasLow;
+		bool hasHigh;
+	};
+
+	vector<FingerEntry> finger;	//root to last FingerFind position
+	unsigned version;			//bumped by every change to the shape of the tree
+	unsigned fingerVersion;		//version finger was recorded at
+	vector<node*> insertPath;	//root to the node ScapegoatInsert checks, kept so its room is reused
+
+	HashIndexClass* hashIndex;	//key to node side index. nullptr when off
+	bool cursorPending;			//true while currPos came from the hash index and prevPos is not set yet
+	KeyType pendingKey;			//key of the Find that left cursorPending set
+	CuckooFilterClass* filter;	//membership filter in front of Find. nullptr when off
+	PayloadArenaClass* payloads;	//out of line payload storage. nullptr until the first SetPayload
+	vector<shared_ptr<node> > nodeBlocks;	//blocks the nodes of BuildFromSorted and LoadFile are carved from.
+											//shared with the lists Split hands their nodes to
+	bool multiset;				//true if a repeated key raises the count of its node
+	bool expandCopies;			//true if NextPosition visits every copy of a key (multiset mode)
+	node* copyOf;				//node whose copies NextPosition is stepping through, nullptr for none
+	int copyIndex;				//copy of copyOf the cursor is on, 0 is the first
 };
@@ -0,0 +1,670 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: PageCache.cpp
+Purpose: Provides the implementation for the page cache DiskListClass keeps its tree in.
+Input: All input is done via DiskListClass
+Output: The scratch file
+Assumptions: One thread uses the cache. Only the prefetch reads run on the pool.
+*/
+
+
+#include "PageCache.h"
+#include "Exceptions.h"
+
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+//Pre: file is open
+//Post: up to size bytes at offset of file have been read into bytes. returns how many to the caller, 0 at the
+//		end of the file and -1 on an error. positioned, so reads on the pool never share a file offset
+static long long ReadAt(/*in*/FileHandle file,			//file to read
+						/*out*/char* bytes,				//where to put the bytes
+						/*in*/int size,					//most bytes to read
+						/*in*/long long offset)			//where in the file
+{
+#ifdef _WIN32
+	OVERLAPPED at = {};
+	DWORD count = 0;
+
+	at.Offset = (DWORD)((unsigned long long)offset & 0xFFFFFFFFull);
+	at.OffsetHigh = (DWORD)((unsigned long long)offset >> 32);
+	if (!ReadFile((HANDLE)file, bytes, (DWORD)size, &count, &at))
+	{
+		return (GetLastError() == ERROR_HANDLE_EOF) ? 0 : -1;
+
+	}//end if
+
+	return (long long)count;
+#else
+	return (long long)pread(file, bytes, size, (off_t)offset);
+#endif
+
+}//end ReadAt
+
+
+/*****************************************************************************************************/
+
+//Pre: file is open
+//Post: up to size bytes of bytes have been written at offset of file. returns how many to the caller, -1 on
+//		an error
+static long long WriteAt(	/*in*/FileHandle file,			//file to write
+							/*in*/const char* bytes,		//bytes to write
+							/*in*/int size,					//number of bytes
+							/*in*/long long offset)			//where in the file
+{
+#ifdef _WIN32
+	OVERLAPPED at = {};
+	DWORD count = 0;
+
+	at.Offset = (DWORD)((unsigned long long)offset & 0xFFFFFFFFull);
+	at.OffsetHigh = (DWORD)((unsigned long long)offset >> 32);
+	if (!WriteFile((HANDLE)file, bytes, (DWORD)size, &count, &at))
+	{
+		return -1;
+
+	}//end if
+
+	return (long long)count;
+#else
+	return (long long)pwrite(file, bytes, size, (off_t)offset);
+#endif
+
+}//end WriteAt
+
+
+/*****************************************************************************************************/
+
+//Pre: capacity > 0, pool is nullptr or outlives the cache
+//Post: a new empty cache of capacity frames (at least MIN_CAPACITY) has been created over the scratch file
+//		fileName, which is created or emptied. prefetches run on pool (nullptr for the default pool)
+//Exceptions thrown: throws a FileException if fileName can not be created
+//					 throws an OutOfMemoryException if the freestore is out of memory
+PageCacheClass::PageCacheClass(	/*in*/string fileName,				//scratch file
+								/*in*/int capacity,					//pages held in memory
+								/*in*/ThreadPoolClass* pool)		//pool the prefetches run on
+{
+	Frame empty = { NO_PAGE, 0, false, false, false, false };
+
+	if (capacity < MIN_CAPACITY)
+	{
+		capacity = MIN_CAPACITY;
+
+	}//end if
+
+	try
+	{
+		memory.resize((size_t)capacity * PAGE_SIZE);
+		frames.assign(capacity, empty);
+		where.reserve(capacity);
+		this->fileName = fileName;
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	//positioned reads and writes, so a prefetch on the pool and a write back here never share a file offset
+
+#ifdef _WIN32
+	HANDLE opened = CreateFileA(fileName.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_TEMPORARY, nullptr);
+
+	if (opened == INVALID_HANDLE_VALUE)
+	{
+		throw FileException();
+
+	}//end if
+
+	file = (FileHandle)opened;
+#else
+	file = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (file < 0)
+	{
+		throw FileException();
+
+	}//end if
+#endif
+
+	this->pool = (pool != nullptr) ? pool : ThreadPoolClass::Default();
+	hand = 0;
+	loading = 0;
+	pageCount = 0;
+	ResetStats();
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: the prefetches have finished, the memory has been released and the scratch file removed
+PageCacheClass::~PageCacheClass()
+{
+	try
+	{
+		pool->Wait(prefetchGroup);
+
+	}//end try
+
+	catch (...)
+	{
+		//a page that could not be read ahead is going anyway
+
+	}//end catch
+
+#ifdef _WIN32
+	CloseHandle((HANDLE)file);
+	DeleteFileA(fileName.c_str());
+#else
+	close(file);
+	unlink(fileName.c_str());
+#endif
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: returns a new page, every byte 0, to the caller and sets bytes to its PAGE_SIZE bytes. it is pinned
+//		and dirty, and reaches the file when it is evicted
+//Exceptions thrown: throws a FileException if a page can not be written back to make room
+//					 throws an OutOfMemoryException if every frame is pinned
+PageId PageCacheClass::Allocate(/*out*/char*& bytes) //bytes of the new page
+{
+	int victim = Victim(true);
+	PageId page = freePages.empty() ? pageCount : freePages.back();
+
+	try
+	{
+		where[page] = victim;
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	Frame& temp = frames[victim];
+
+	bytes = &memory[(size_t)victim * PAGE_SIZE];
+	memset(bytes, 0, PAGE_SIZE);
+	temp.page = page;
+	temp.pins = 1;
+	temp.dirty = true;
+	temp.referenced = true;
+
+	if (freePages.empty())
+	{
+		++pageCount;
+
+	}//end if
+
+	else
+	{
+		freePages.pop_back();
+
+	}//end else
+
+	return page;
+
+}//end Allocate
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, page was returned by Allocate and is not pinned
+//Post: page has been dropped from memory without being written back and put on the free list, so that
+//		Allocate hands it out again. if the free list can not grow the page is just left unused in the file
+void PageCacheClass::Release(/*in*/PageId page) //page no longer used
+{
+	unordered_map<PageId, int>::iterator found = where.find(page);
+
+	try
+	{
+		freePages.push_back(page);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		//only costs room in the file until it is cleared
+
+	}//end catch
+
+	if (found != where.end() && frames[found->second].loading)
+	{
+		//a prefetch is still reading into the frame: let it finish before the frame is freed
+
+		Settle();
+		found = where.find(page);
+
+	}//end if
+
+	if (found != where.end())
+	{
+		Frame& temp = frames[found->second];
+
+		temp.page = NO_PAGE;
+		temp.dirty = false;
+		temp.referenced = false;
+		temp.prefetched = false;
+		where.erase(found);
+
+	}//end if
+
+}//end Release
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, page was returned by Allocate
+//Post: page is in memory and pinned once more. returns its PAGE_SIZE bytes to the caller, they stay put
+//		until the last pin is released
+//Exceptions thrown: throws a FileException if the page can not be read, or another written back
+//					 throws an OutOfMemoryException if every frame is pinned
+char* PageCacheClass::Pin(/*in*/PageId page) //page to use
+{
+	unordered_map<PageId, int>::iterator found = where.find(page);
+
+	if (found != where.end() && frames[found->second].loading)
+	{
+		//read ahead but not finished: wait for it rather than read the page a second time
+
+		Settle();
+		found = where.find(page);
+
+	}//end if
+
+	if (found != where.end())
+	{
+		Frame& temp = frames[found->second];
+
+		++temp.pins;
+		temp.referenced = true;
+		++counters.hits;
+		if (temp.prefetched)
+		{
+			++counters.prefetchHits;
+			temp.prefetched = false;
+
+		}//end if
+
+		return &memory[(size_t)found->second * PAGE_SIZE];
+
+	}//end if
+
+	int victim = Victim(true);
+	char* bytes = &memory[(size_t)victim * PAGE_SIZE];
+
+	ReadPage(page, bytes);		//the frame stays empty if this throws
+	try
+	{
+		where[page] = victim;
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		throw OutOfMemoryException();
+
+	}//end catch
+
+	Frame& temp = frames[victim];
+
+	temp.page = page;
+	temp.pins = 1;
+	temp.dirty = false;
+	temp.referenced = true;
+	++counters.misses;
+	return bytes;
+
+}//end Pin
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, page is pinned
+//Post: one pin of page has been released. if dirty is true the page is written back before it is evicted
+void PageCacheClass::Unpin(	/*in*/PageId page,		//page done with
+							/*in*/bool dirty)		//true if its bytes were changed
+{
+	Frame& temp = frames[where[page]];
+
+	--temp.pins;
+	temp.dirty = temp.dirty || dirty;
+
+}//end Unpin
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, page is NO_PAGE or was returned by Allocate
+//Post: the read of page into a free frame has been started on the pool. nothing is done for NO_PAGE, a page
+//		that is cached or being read, or when the only frames left are in use
+//Exceptions thrown: throws a FileException if a page can not be written back to make room
+void PageCacheClass::Prefetch(/*in*/PageId page) //page about to be used
+{
+	if (page == NO_PAGE || page >= pageCount || where.count(page) > 0)
+	{
+		return;
+
+	}//end if
+
+	int victim = Victim(false);
+	if (victim < 0)
+	{
+		return;
+
+	}//end if
+
+	//not marked referenced: a page read ahead that is never used is the first one the hand takes back
+
+	Frame& temp = frames[victim];
+	char* bytes = &memory[(size_t)victim * PAGE_SIZE];
+
+	try
+	{
+		where[page] = victim;
+		temp.page = page;
+		temp.loading = true;
+		temp.prefetched = true;
+		++loading;
+		pool->Spawn(prefetchGroup, [this, page, bytes]() { ReadPage(page, bytes); });
+		++counters.prefetches;
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		//only a hint, the page is read when it is pinned
+
+		if (temp.loading)
+		{
+			--loading;
+
+		}//end if
+
+		where.erase(page);
+		temp.page = NO_PAGE;
+		temp.loading = false;
+		temp.prefetched = false;
+
+	}//end catch
+
+}//end Prefetch
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, no page is pinned
+//Post: every page has been dropped without being written back and the scratch file emptied
+//Exceptions thrown: throws a FileException if the file can not be emptied
+void PageCacheClass::Clear()
+{
+	Frame empty = { NO_PAGE, 0, false, false, false, false };
+
+	Settle();
+	frames.assign(frames.size(), empty);
+	where.clear();
+	freePages.clear();
+	hand = 0;
+	pageCount = 0;
+
+#ifdef _WIN32
+	LARGE_INTEGER start = {};
+
+	if (!SetFilePointerEx((HANDLE)file, start, nullptr, FILE_BEGIN) || !SetEndOfFile((HANDLE)file))
+	{
+		throw FileException();
+
+	}//end if
+#else
+	if (ftruncate(file, 0) != 0)
+	{
+		throw FileException();
+
+	}//end if
+#endif
+
+}//end Clear
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: returns the number of pages in the file to the caller, released ones included
+int PageCacheClass::ReturnPageCount() const
+{
+	return pageCount;
+
+}//end ReturnPageCount
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: returns the number of frames to the caller
+int PageCacheClass::ReturnCapacity() const
+{
+	return (int)frames.size();
+
+}//end ReturnCapacity
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: returns the counters to the caller
+CacheStats PageCacheClass::Stats() const
+{
+	return counters;
+
+}//end Stats
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: every counter has been set back to zero
+void PageCacheClass::ResetStats()
+{
+	CacheStats temp = { 0, 0, 0, 0, 0, 0 };
+
+	counters = temp;
+
+}//end ResetStats
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: returns a frame that is not pinned or being read to the caller, its old page written back if it was
+//		dirty and dropped. the hand passes every frame used since it last came by, clearing its mark. returns
+//		-1 if wait is false and every frame is in use, otherwise the prefetches are waited for first
+//Exceptions thrown: throws a FileException if the old page can not be written back
+//					 throws an OutOfMemoryException if every frame is pinned
+int PageCacheClass::Victim(/*in*/bool wait) //true to wait for the prefetches rather than give up
+{
+	//two sweeps: the first may only clear marks, the second then finds a frame unless all are in use
+
+	for (size_t step = 0; step < 2 * frames.size(); ++step)
+	{
+		int current = hand;
+		Frame& temp = frames[current];
+
+		hand = (hand + 1) % (int)frames.size();
+
+		if (temp.pins > 0 || temp.loading)
+		{
+			continue;
+
+		}//end if
+
+		if (temp.page != NO_PAGE && temp.referenced)
+		{
+			temp.referenced = false;
+			continue;
+
+		}//end if
+
+		if (temp.page != NO_PAGE)
+		{
+			if (temp.dirty)
+			{
+				WritePage(temp.page, &memory[(size_t)current * PAGE_SIZE]);
+				++counters.writes;
+
+			}//end if
+
+			where.erase(temp.page);
+			++counters.evictions;
+
+		}//end if
+
+		temp.page = NO_PAGE;
+		temp.dirty = false;
+		temp.referenced = false;
+		temp.prefetched = false;
+		return current;
+
+	}//end for
+
+	if (!wait)
+	{
+		return -1;
+
+	}//end if
+
+	if (loading > 0)
+	{
+		Settle();
+		return Victim(wait);
+
+	}//end if
+
+	throw OutOfMemoryException();
+
+}//end Victim
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated
+//Post: every prefetch has finished and the frames it read into can be used. a page a prefetch could not read
+//		is dropped, and read again (throwing then if it still fails) by the Pin that wants it
+void PageCacheClass::Settle()
+{
+	bool failed = false;
+
+	if (loading == 0)
+	{
+		return;
+
+	}//end if
+
+	try
+	{
+		pool->Wait(prefetchGroup);
+
+	}//end try
+
+	catch (...)
+	{
+		failed = true;
+
+	}//end catch
+
+	for (size_t i = 0; i < frames.size(); ++i)
+	{
+		if (frames[i].loading)
+		{
+			frames[i].loading = false;
+			if (failed)
+			{
+				//which read failed is not known, so every page of the batch is dropped
+
+				where.erase(frames[i].page);
+				frames[i].page = NO_PAGE;
+				frames[i].prefetched = false;
+
+			}//end if
+
+		}//end if
+
+	}//end for
+
+	loading = 0;
+
+}//end Settle
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, bytes has room for PAGE_SIZE bytes
+//Post: bytes holds page as it is in the file. safe to call from the pool while the cache is in use
+//Exceptions thrown: throws a FileException if the page can not be read
+void PageCacheClass::ReadPage(	/*in*/PageId page,			//page to read
+								/*out*/char* bytes) const	//where to put it
+{
+	long long offset = (long long)page * PAGE_SIZE;
+	int done = 0;
+
+	while (done < PAGE_SIZE)
+	{
+		long long count = ReadAt(file, bytes + done, PAGE_SIZE - done, offset + done);
+
+		if (count <= 0)
+		{
+			throw FileException();
+
+		}//end if
+
+		done += (int)count;
+
+	}//end while
+
+}//end ReadPage
+
+
+/*****************************************************************************************************/
+
+//Pre: PageCacheClass has been instantiated, bytes holds PAGE_SIZE bytes
+//Post: page in the file holds bytes
+//Exceptions thrown: throws a FileException if the page can not be written
+void PageCacheClass::WritePage(	/*in*/PageId page,			//page to write
+								/*in*/const char* bytes)	//its bytes
+{
+	long long offset = (long long)page * PAGE_SIZE;
+	int done = 0;
+
+	while (done < PAGE_SIZE)
+	{
+		long long count = WriteAt(file, bytes + done, PAGE_SIZE - done, offset + done);
+
+		if (count <= 0)
+		{
+			throw FileException();
+
+		}//end if
+
+		done += (int)count;
+
+	}//end while
+
+}//end WritePage
@@ -0,0 +1,282 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: PageCache.h
+Purpose: Provides the specification for the page cache DiskListClass keeps its tree in.
+		The pages live in a scratch file, and at most capacity of them are held in memory at a time, in frames.
+		A page is pinned while it is being used, so it can not be evicted underneath the caller. When a page
+		that is not cached is asked for, the CLOCK hand sweeps the frames for one that is not pinned and has not
+		been used since the hand last passed it, writes it back if it is dirty, and reads the page into it.
+		Prefetch starts the read of a page on the thread pool, so a sequential scan overlaps reading the next
+		page with working through the current one.
+Input: All input is done via DiskListClass
+Output: The scratch file
+Assumptions: One thread uses the cache. Only the prefetch reads run on the pool.
+*/
+
+#ifndef PAGE_CACHE
+#define PAGE_CACHE
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ThreadPool.h"
+
+using namespace std;
+
+//names a page of the file, numbered from 0
+typedef int PageId;
+
+const PageId NO_PAGE = -1;
+
+//the open scratch file: a HANDLE on Windows (kept as void* so that windows.h stays out of the header), a file
+//descriptor elsewhere
+#ifdef _WIN32
+typedef void* FileHandle;
+#else
+typedef int FileHandle;
+#endif
+
+//counters kept by the cache since construction or ResetStats
+struct CacheStats
+{
+	long long hits;				//Pins answered from memory
+	long long misses;			//Pins that had to read the page
+	long long prefetches;		//pages read ahead by Prefetch
+	long long prefetchHits;		//Pins answered by a page Prefetch read
+	long long evictions;		//pages dropped to make room
+	long long writes;			//dirty pages written back to the file
+};
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+PageCacheClass(string fileName, int capacity, ThreadPoolClass* pool);
+	a new empty cache of capacity frames has been created over the new scratch file fileName
+
+~PageCacheClass();
+	the prefetches have finished, the memory has been released and the scratch file removed
+
+PageId Allocate(char*& bytes);
+	returns a new zeroed page, pinned and dirty, and its bytes to the caller. released pages are used first
+
+void Release(PageId page);
+	page is no longer used and has been put on the free list for Allocate
+
+char* Pin(PageId page);
+	page is in memory and pinned. returns its bytes to the caller
+
+void Unpin(PageId page, bool dirty);
+	one pin of page has been released. dirty marks it for writing back
+
+void Prefetch(PageId page);
+	the read of page has been started on the pool, unless it is cached or no frame is free
+
+void Clear();
+	every page has been dropped and the scratch file emptied
+
+int ReturnPageCount() const;
+	returns the number of pages in the file to the caller
+
+int ReturnCapacity() const;
+	returns the number of frames to the caller
+
+CacheStats Stats() const;
+	returns the counters to the caller
+
+void ResetStats();
+	every counter has been set back to zero
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+int Victim(bool wait);
+	returns a frame that may be reused to the caller, its old page written back and dropped
+
+void Settle();
+	every prefetch has finished and its frame can be used
+
+void ReadPage(PageId page, char* bytes) const;
+	bytes holds page as it is in the file
+
+void WritePage(PageId page, const char* bytes);
+	page in the file holds bytes
+*/
+
+class PageCacheClass
+{
+
+public:
+
+	static const int PAGE_SIZE = 4096;		//bytes per page
+	static const int MIN_CAPACITY = 16;		//fewest frames, enough for a descent that splits pages on every level
+
+	/*****************************************************************************************************/
+
+	//Pre: capacity > 0, pool is nullptr or outlives the cache
+	//Post: a new empty cache of capacity frames (at least MIN_CAPACITY) has been created over the scratch file
+	//		fileName, which is created or emptied. prefetches run on pool (nullptr for the default pool)
+	//Exceptions thrown: throws a FileException if fileName can not be created
+	//					 throws an OutOfMemoryException if the freestore is out of memory
+	PageCacheClass(	/*in*/string fileName,				//scratch file
+					/*in*/int capacity,					//pages held in memory
+					/*in*/ThreadPoolClass* pool);		//pool the prefetches run on
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: the prefetches have finished, the memory has been released and the scratch file removed
+	~PageCacheClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: returns a new page, every byte 0, to the caller and sets bytes to its PAGE_SIZE bytes. it is pinned
+	//		and dirty, and reaches the file when it is evicted. a page given back by Release is used before the
+	//		file grows
+	//Exceptions thrown: throws a FileException if a page can not be written back to make room
+	//					 throws an OutOfMemoryException if every frame is pinned
+	PageId Allocate(/*out*/char*& bytes); //bytes of the new page
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, page was returned by Allocate and is not pinned
+	//Post: page has been dropped from memory without being written back and put on the free list, so that
+	//		Allocate hands it out again. if the free list can not grow the page is just left unused in the file
+	void Release(/*in*/PageId page); //page no longer used
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, page was returned by Allocate
+	//Post: page is in memory and pinned once more. returns its PAGE_SIZE bytes to the caller, they stay put
+	//		until the last pin is released
+	//Exceptions thrown: throws a FileException if the page can not be read, or another written back
+	//					 throws an OutOfMemoryException if every frame is pinned
+	char* Pin(/*in*/PageId page); //page to use
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, page is pinned
+	//Post: one pin of page has been released. if dirty is true the page is written back before it is evicted
+	void Unpin(	/*in*/PageId page,		//page done with
+				/*in*/bool dirty);		//true if its bytes were changed
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, page is NO_PAGE or was returned by Allocate
+	//Post: the read of page into a free frame has been started on the pool. nothing is done for NO_PAGE, a page
+	//		that is cached or being read, or when the only frames left are in use
+	//Exceptions thrown: throws a FileException if a page can not be written back to make room
+	void Prefetch(/*in*/PageId page); //page about to be used
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, no page is pinned
+	//Post: every page has been dropped without being written back and the scratch file emptied
+	//Exceptions thrown: throws a FileException if the file can not be emptied
+	void Clear();
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: returns the number of pages in the file to the caller, released ones included
+	int ReturnPageCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: returns the number of frames to the caller
+	int ReturnCapacity() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: returns the counters to the caller
+	CacheStats Stats() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: every counter has been set back to zero
+	void ResetStats();
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: returns a frame that is not pinned or being read to the caller, its old page written back if it was
+	//		dirty and dropped. the hand passes every frame used since it last came by, clearing its mark. returns
+	//		-1 if wait is false and every frame is in use, otherwise the prefetches are waited for first
+	//Exceptions thrown: throws a FileException if the old page can not be written back
+	//					 throws an OutOfMemoryException if every frame is pinned
+	int Victim(/*in*/bool wait); //true to wait for the prefetches rather than give up
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated
+	//Post: every prefetch has finished and the frames it read into can be used. a page a prefetch could not read
+	//		is dropped, and read again (throwing then if it still fails) by the Pin that wants it
+	void Settle();
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, bytes has room for PAGE_SIZE bytes
+	//Post: bytes holds page as it is in the file. safe to call from the pool while the cache is in use
+	//Exceptions thrown: throws a FileException if the page can not be read
+	void ReadPage(	/*in*/PageId page,			//page to read
+					/*out*/char* bytes) const;	//where to put it
+
+	/*****************************************************************************************************/
+
+	//Pre: PageCacheClass has been instantiated, bytes holds PAGE_SIZE bytes
+	//Post: page in the file holds bytes
+	//Exceptions thrown: throws a FileException if the page can not be written
+	void WritePage(	/*in*/PageId page,			//page to write
+					/*in*/const char* bytes);	//its bytes
+
+	/*****************************************************************************************************/
+
+private:
+
+	struct Frame
+	{
+		PageId page;		//page held, NO_PAGE for an empty frame
+		int pins;			//callers using the page
+		bool dirty;			//changed since it was read
+		bool referenced;	//used since the hand last passed
+		bool loading;		//a prefetch is reading into the frame
+		bool prefetched;	//read by a prefetch and not pinned since
+	};
+
+	string fileName;					//scratch file
+	FileHandle file;					//the open scratch file
+	vector<char> memory;				//frame i holds memory[i * PAGE_SIZE ...]
+	vector<Frame> frames;				//every frame
+	unordered_map<PageId, int> where;	//frame of every cached page
+	int hand;							//next frame the CLOCK hand looks at
+	int loading;						//frames a prefetch is reading into
+	PageId pageCount;					//pages in the file
+	vector<PageId> freePages;			//released pages, reused by Allocate before the file grows
+	ThreadPoolClass* pool;				//pool the prefetches run on
+	TaskGroup prefetchGroup;			//prefetches started since the last Settle
+	CacheStats counters;				//since construction or ResetStats
+
+	//no copies, the frames belong to one file
+	PageCacheClass(const PageCacheClass&);
+	void operator=(const PageCacheClass&);
+
+};
+
+#endif
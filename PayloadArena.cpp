@@ -0,0 +1,322 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: PayloadArena.cpp
+Purpose: Provides the implementation for the arena OrdListClass keeps item payloads in.
+Input: All input is done via OrdListClass
+Output: none
+Assumptions: A view stays valid until the payload it shows is replaced or released, or the arena is cleared.
+*/
+
+
+#include "PayloadArena.h"
+
+#include <cstring>
+
+using namespace std;
+
+//Pre: size >= 0
+//Post: returns the space a payload of size bytes is given: size rounded up to a multiple of GRANULE, at least one
+static int CapacityOf(/*in*/int size) //bytes of payload
+{
+	int capacity = (size + PayloadArenaClass::GRANULE - 1) / PayloadArenaClass::GRANULE * PayloadArenaClass::GRANULE;
+	return (capacity > 0) ? capacity : PayloadArenaClass::GRANULE;
+
+}//end CapacityOf
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: a new empty arena has been created. no chunk is allocated until the first payload is stored
+PayloadArenaClass::PayloadArenaClass()
+	: freeSpace(MAX_SMALL / GRANULE)
+{
+	chunkUsed = 0;
+	chunksInUse = 0;
+	largeBytes = 0;
+	count = 0;
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated
+//Post: every chunk has been returned to the freestore
+PayloadArenaClass::~PayloadArenaClass()
+{
+	Clear();
+
+	for (size_t i = 0; i < chunks.size(); ++i)
+	{
+		delete[] chunks[i];
+
+	}//end for
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated, bytes holds size bytes (size >= 0)
+//Post: a copy of bytes has been stored. returns its handle (never NO_PAYLOAD) to the caller
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+PayloadHandle PayloadArenaClass::Store(	/*in*/const char* bytes,	//payload to copy
+										/*in*/int size)				//number of bytes
+{
+	Entry temp;
+	PayloadHandle handle;
+
+	if (freeHandles.empty())
+	{
+		entries.reserve(entries.size() + 1);		//may throw, nothing has changed yet
+
+	}//end if
+
+	temp.capacity = CapacityOf(size);
+	temp.data = Carve(temp.capacity);
+	temp.size = size;
+	memcpy(temp.data, bytes, size);
+
+	if (!freeHandles.empty())
+	{
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+		entries[handle - 1] = temp;
+
+	}//end if
+
+	else
+	{
+		entries.push_back(temp);
+		handle = (PayloadHandle)entries.size();
+
+	}//end else
+
+	++count;
+	return handle;
+
+}//end Store
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated, handle is NO_PAYLOAD or was returned by Store
+//Post: the payload of handle now holds a copy of bytes, in place when it fits the old space. returns the
+//		handle that now names it (a new one if handle was NO_PAYLOAD). views of the old bytes are invalid
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory, the old payload is then unchanged
+PayloadHandle PayloadArenaClass::Replace(	/*in*/PayloadHandle handle,		//payload to overwrite
+											/*in*/const char* bytes,		//payload to copy
+											/*in*/int size)					//number of bytes
+{
+	if (handle == NO_PAYLOAD)
+	{
+		return Store(bytes, size);
+
+	}//end if
+
+	Entry& temp = entries[handle - 1];
+
+	//bytes may be a view of this very payload, so the old space is only given back after the copy
+
+	if (size > temp.capacity)
+	{
+		int capacity = CapacityOf(size);
+		char* space = Carve(capacity);
+
+		memcpy(space, bytes, size);
+		Recycle(temp.data, temp.capacity);
+		temp.data = space;
+		temp.capacity = capacity;
+
+	}//end if
+
+	else
+	{
+		memmove(temp.data, bytes, size);
+
+	}//end else
+
+	temp.size = size;
+	return handle;
+
+}//end Replace
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated, handle is NO_PAYLOAD or was returned by Store
+//Post: the space of handle has been put back for reuse. NO_PAYLOAD is ignored. never throws, so a tree can be
+//		released node by node without a failure half way
+void PayloadArenaClass::Release(/*in*/PayloadHandle handle) //payload to free
+{
+	if (handle == NO_PAYLOAD)
+	{
+		return;
+
+	}//end if
+
+	Entry& temp = entries[handle - 1];
+
+	try
+	{
+		Recycle(temp.data, temp.capacity);
+		freeHandles.push_back(handle);
+
+	}//end try
+
+	catch (bad_alloc&)
+	{
+		//the space or the handle is not reused, it goes with the arena
+
+	}//end catch
+
+	temp.data = nullptr;
+	temp.size = 0;
+	temp.capacity = 0;
+	--count;
+
+}//end Release
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated, handle is NO_PAYLOAD or was returned by Store
+//Post: returns a view of the payload of handle to the caller. { nullptr, 0 } for NO_PAYLOAD
+PayloadView PayloadArenaClass::View(/*in*/PayloadHandle handle) const //payload to look at
+{
+	PayloadView temp = { nullptr, 0 };
+
+	if (handle != NO_PAYLOAD)
+	{
+		temp.data = entries[handle - 1].data;
+		temp.size = entries[handle - 1].size;
+
+	}//end if
+
+	return temp;
+
+}//end View
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated
+//Post: every payload has been released. the chunks are kept for reuse
+void PayloadArenaClass::Clear()
+{
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		if (entries[i].data != nullptr && entries[i].capacity > MAX_SMALL)
+		{
+			delete[] entries[i].data;
+
+		}//end if
+
+	}//end for
+
+	for (size_t i = 0; i < freeSpace.size(); ++i)
+	{
+		freeSpace[i].clear();
+
+	}//end for
+
+	entries.clear();
+	freeHandles.clear();
+	chunkUsed = 0;
+	chunksInUse = 0;
+	largeBytes = 0;
+	count = 0;
+
+}//end Clear
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated
+//Post: returns the number of payloads stored to the caller
+int PayloadArenaClass::ReturnCount() const
+{
+	return count;
+
+}//end ReturnCount
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated
+//Post: returns the number of bytes held by the arena (chunks, large blocks and the handle table) to the caller
+long long PayloadArenaClass::ReturnBytes() const
+{
+	return (long long)chunks.size() * CHUNK_SIZE + largeBytes + (long long)entries.capacity() * sizeof(Entry);
+
+}//end ReturnBytes
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated, capacity is a multiple of GRANULE
+//Post: returns capacity bytes of space to the caller, from the free list of its size class, the current
+//		chunk, or (past MAX_SMALL) a block of its own
+//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+char* PayloadArenaClass::Carve(/*in*/int capacity) //bytes wanted
+{
+	if (capacity > MAX_SMALL)
+	{
+		char* temp = new char[capacity];
+		largeBytes += capacity;
+		return temp;
+
+	}//end if
+
+	vector<char*>& reuse = freeSpace[capacity / GRANULE - 1];
+	if (!reuse.empty())
+	{
+		char* temp = reuse.back();
+		reuse.pop_back();
+		return temp;
+
+	}//end if
+
+	//the tail of a chunk too short for this payload is left unused, at most MAX_SMALL bytes of every chunk
+	if (chunksInUse == 0 || chunkUsed + capacity > CHUNK_SIZE)
+	{
+		if (chunksInUse == (int)chunks.size())
+		{
+			chunks.reserve(chunks.size() + 1);
+			chunks.push_back(new char[CHUNK_SIZE]);		//cannot throw once the chunk exists
+
+		}//end if
+
+		++chunksInUse;
+		chunkUsed = 0;
+
+	}//end if
+
+	char* temp = chunks[chunksInUse - 1] + chunkUsed;
+	chunkUsed += capacity;
+	return temp;
+
+}//end Carve
+
+
+/*****************************************************************************************************/
+
+//Pre: PayloadArenaClass has been instantiated, space came from Carve(capacity)
+//Post: space has been put on the free list of its size class (large blocks are freed)
+void PayloadArenaClass::Recycle(/*in*/char* space,		//space to give back
+								/*in*/int capacity)		//bytes it holds
+{
+	if (capacity > MAX_SMALL)
+	{
+		delete[] space;
+		largeBytes -= capacity;
+		return;
+
+	}//end if
+
+	freeSpace[capacity / GRANULE - 1].push_back(space);
+
+}//end Recycle
@@ -0,0 +1,198 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: PayloadArena.h
+Purpose: Provides the specification for the arena OrdListClass keeps item payloads in.
+		A tree node only holds its key, its links and a 4 byte handle, so a descent touches one small node per
+		level however large the values are. The payload bytes live here, packed into large chunks, and are
+		found through the handle. Space is handed out in 16 byte size classes, and freed space goes on the free
+		list of its class for the next payload of that size.
+Input: All input is done via OrdListClass
+Output: none
+Assumptions: A view stays valid until the payload it shows is replaced or released, or the arena is cleared.
+*/
+
+#ifndef PAYLOAD_ARENA
+#define PAYLOAD_ARENA
+
+#include <vector>
+
+using namespace std;
+
+//names a payload in an arena. 0 is no payload
+typedef unsigned PayloadHandle;
+
+const PayloadHandle NO_PAYLOAD = 0;
+
+//read only window onto payload bytes that stay in the arena
+struct PayloadView
+{
+	const char* data;	//first byte, nullptr when there is no payload
+	int size;			//number of bytes
+};
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+PayloadArenaClass();
+	a new empty arena has been created
+
+~PayloadArenaClass();
+	every chunk has been returned to the freestore
+
+PayloadHandle Store(const char* bytes, int size);
+	a copy of bytes has been stored. returns its handle to the caller
+
+PayloadHandle Replace(PayloadHandle handle, const char* bytes, int size);
+	the payload of handle now holds a copy of bytes. returns the handle that now names it
+
+void Release(PayloadHandle handle);
+	the space of handle has been put back for reuse
+
+PayloadView View(PayloadHandle handle) const;
+	returns a view of the payload of handle to the caller
+
+void Clear();
+	every payload has been released. the chunks are kept for reuse
+
+int ReturnCount() const;
+	returns the number of payloads stored to the caller
+
+long long ReturnBytes() const;
+	returns the number of bytes held by the arena to the caller
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+char* Carve(int capacity);
+	returns capacity bytes of space to the caller, from a free list or the current chunk
+
+void Recycle(char* space, int capacity);
+	space has been put on the free list of its size class
+*/
+
+class PayloadArenaClass
+{
+
+public:
+
+	static const int CHUNK_SIZE = 1 << 20;		//bytes per chunk
+	static const int MAX_SMALL = 4096;			//larger payloads get a block of their own
+	static const int GRANULE = 16;				//payload space is rounded up to a multiple of this
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: a new empty arena has been created. no chunk is allocated until the first payload is stored
+	PayloadArenaClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated
+	//Post: every chunk has been returned to the freestore
+	~PayloadArenaClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated, bytes holds size bytes (size >= 0)
+	//Post: a copy of bytes has been stored. returns its handle (never NO_PAYLOAD) to the caller
+	//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+	PayloadHandle Store(/*in*/const char* bytes,	//payload to copy
+						/*in*/int size);			//number of bytes
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated, handle is NO_PAYLOAD or was returned by Store
+	//Post: the payload of handle now holds a copy of bytes, in place when it fits the old space. returns the
+	//		handle that now names it (a new one if handle was NO_PAYLOAD). views of the old bytes are invalid
+	//Exceptions thrown: throws bad_alloc if the freestore is out of memory, the old payload is then unchanged
+	PayloadHandle Replace(	/*in*/PayloadHandle handle,		//payload to overwrite
+							/*in*/const char* bytes,		//payload to copy
+							/*in*/int size);				//number of bytes
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated, handle is NO_PAYLOAD or was returned by Store
+	//Post: the space of handle has been put back for reuse. NO_PAYLOAD is ignored. never throws, so a tree can be
+	//		released node by node without a failure half way
+	void Release(/*in*/PayloadHandle handle); //payload to free
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated, handle is NO_PAYLOAD or was returned by Store
+	//Post: returns a view of the payload of handle to the caller. { nullptr, 0 } for NO_PAYLOAD
+	PayloadView View(/*in*/PayloadHandle handle) const; //payload to look at
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated
+	//Post: every payload has been released. the chunks are kept for reuse
+	void Clear();
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated
+	//Post: returns the number of payloads stored to the caller
+	int ReturnCount() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated
+	//Post: returns the number of bytes held by the arena (chunks, large blocks and the handle table) to the caller
+	long long ReturnBytes() const;
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated, capacity is a multiple of GRANULE
+	//Post: returns capacity bytes of space to the caller, from the free list of its size class, the current
+	//		chunk, or (past MAX_SMALL) a block of its own
+	//Exceptions thrown: throws bad_alloc if the freestore is out of memory
+	char* Carve(/*in*/int capacity); //bytes wanted
+
+	/*****************************************************************************************************/
+
+	//Pre: PayloadArenaClass has been instantiated, space came from Carve(capacity)
+	//Post: space has been put on the free list of its size class (large blocks are freed)
+	void Recycle(	/*in*/char* space,		//space to give back
+					/*in*/int capacity);	//bytes it holds
+
+	/*****************************************************************************************************/
+
+private:
+
+	struct Entry
+	{
+		char* data;			//payload bytes, nullptr for a free handle
+		int size;			//bytes in use
+		int capacity;		//bytes of space, a multiple of GRANULE
+	};
+
+	vector<Entry> entries;				//entries[handle - 1]
+	vector<PayloadHandle> freeHandles;	//handles ready for reuse
+	vector<char*> chunks;				//every chunk, the last one is being carved
+	int chunkUsed;						//bytes carved from the last chunk
+	int chunksInUse;					//chunks carved from since the last Clear
+	vector<vector<char*> > freeSpace;	//freeSpace[c] holds space of (c + 1) * GRANULE bytes
+	long long largeBytes;				//bytes in blocks of their own
+	int count;							//payloads stored
+
+	//no copies, OrdListClass copies payloads one at a time
+	PayloadArenaClass(const PayloadArenaClass&);
+	void operator=(const PayloadArenaClass&);
+
+};
+
+#endif
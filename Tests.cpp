@@ -0,0 +1,773 @@
+/*
+Author: John Lahut
+Date: 10/19/2026
+Project: OrdList as a BST
+Filename: Tests.cpp
+Purpose: Checks the lists against the standard containers. Every test drives a list and a std::map or std::set
+		with the same operations (random, from fixed seeds so a failure repeats) and compares the two after
+		each step: the keys in order, the length and every lookup.
+Input: none
+Output: One line per failed check, then the number of checks and of failures, on the console. The exit code is 1
+		if any check failed, 0 otherwise
+Assumptions: linked with every .cpp of the project except the other programs (Source1.cpp and Benchmark.cpp)
+*/
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "OrdListADT.h"
+#include "DiskList.h"
+#include "LsmList.h"
+#include "ItemType.h"
+#include "Exceptions.h"
+
+using namespace std;
+
+void Check(bool passed, const string& test, const string& what);
+void Collect(const ItemType& item);
+bool SameKeys(OrdListClass& list, const map<KeyType, int>& expected);
+bool SameCounts(OrdListClass& list, const map<KeyType, int>& expected);
+void Fill(OrdListClass& list, map<KeyType, int>& expected, int count, int range, mt19937& rng);
+void TestSplitJoin();
+void TestEraseRange();
+void TestMultiset();
+void TestFileRoundTrip();
+string ScratchName(const string& name);
+bool SameDiskKeys(DiskListClass& list, const set<KeyType>& expected);
+void TestDiskList();
+void TestLsmList();
+
+static int checks = 0;				//checks made
+static int failures = 0;			//checks that failed
+static vector<KeyType> visited;		//keys Collect has been handed, in order
+
+
+int main()
+{
+	TestSplitJoin();
+	TestEraseRange();
+	TestMultiset();
+	TestFileRoundTrip();
+	TestDiskList();
+	TestLsmList();
+
+	cout << checks << " checks, " << failures << " failed" << endl;
+	return (failures == 0) ? 0 : 1;
+
+}//end main
+
+
+//Pre: none
+//Post: the check has been counted, and reported on the console if it did not pass
+void Check(	/*in*/bool passed,				//true if the check passed
+			/*in*/const string& test,		//test the check belongs to
+			/*in*/const string& what)		//what was checked
+{
+	++checks;
+	if (!passed)
+	{
+		++failures;
+		cout << "FAILED " << test << ": " << what << endl;
+
+	}//end if
+
+}//end Check
+
+
+//Pre: none
+//Post: the key of item has been appended to visited
+void Collect(/*in*/const ItemType& item) //item visited
+{
+	visited.push_back(item.key);
+
+}//end Collect
+
+
+//Pre: none
+//Post: returns true to the caller if list holds exactly the keys of expected, in order, and Find agrees with
+//		expected for every key in and around them
+bool SameKeys(	/*inout*/OrdListClass& list,				//list to compare
+				/*in*/const map<KeyType, int>& expected)	//keys it should hold
+{
+	bool same = (list.ReturnLength() == (int)expected.size());
+	map<KeyType, int>::const_iterator trav = expected.begin();
+
+	visited.clear();
+	list.PrintScreen(Collect);
+	same = same && (visited.size() == expected.size());
+	for (size_t i = 0; same && i < visited.size(); ++i, ++trav)
+	{
+		same = (visited[i] == trav->first);
+
+	}//end for
+
+	for (trav = expected.begin(); same && trav != expected.end(); ++trav)
+	{
+		same = list.Find(trav->first) && (list.Find(trav->first + 1) == (expected.count(trav->first + 1) > 0));
+
+	}//end for
+
+	return same;
+
+}//end SameKeys
+
+
+//Pre: none
+//Post: returns true to the caller if list holds exactly the keys of expected, in order, and Count returns the
+//		number of copies expected maps each key to
+bool SameCounts(/*inout*/OrdListClass& list,				//list to compare
+				/*in*/const map<KeyType, int>& expected)	//copies of every key it should hold
+{
+	bool same = SameKeys(list, expected);
+
+	for (map<KeyType, int>::const_iterator trav = expected.begin(); same && trav != expected.end(); ++trav)
+	{
+		same = (list.Count(trav->first) == trav->second);
+
+	}//end for
+
+	return same;
+
+}//end SameCounts
+
+
+//Pre: none
+//Post: returns the path of the scratch file name in the system temp directory (the current directory if
+//		there is none) to the caller
+string ScratchName(/*in*/const string& name) //file name
+{
+	try
+	{
+		return (filesystem::temp_directory_path() / name).string();
+
+	}//end try
+
+	catch (filesystem::filesystem_error&)
+	{
+		return name;
+
+	}//end catch
+
+}//end ScratchName
+
+
+//Pre: list and expected hold the same keys
+//Post: up to count random keys in [0, range) have been inserted into both
+void Fill(	/*inout*/OrdListClass& list,				//list to fill
+			/*inout*/map<KeyType, int>& expected,		//keys it holds
+			/*in*/int count,							//keys to try
+			/*in*/int range,							//keys are below this
+			/*inout*/mt19937& rng)						//random source
+{
+	ItemType item;
+
+	for (int i = 0; i < count; ++i)
+	{
+		item.key = (KeyType)(rng() % range);
+		if (!list.Find(item.key))
+		{
+			list.Insert(item);
+			expected[item.key] = 1;
+
+		}//end if
+
+	}//end for
+
+}//end Fill
+
+
+//Pre: none
+//Post: Split and Join have been checked in every balance mode, with and without a hash index, filter and
+//		payloads: the two pieces hold exactly the keys either side of the split key, payloads travel with
+//		their keys, and joining the pieces back gives the whole list
+void TestSplitJoin()
+{
+	const string test = "Split/Join";
+	BalanceModeType modes[3] = { BALANCE_NONE, BALANCE_SCAPEGOAT, BALANCE_SPLAY };
+	mt19937 rng(43);
+
+	for (int m = 0; m < 3; ++m)
+	{
+		for (int side = 0; side < 2; ++side)
+		{
+			OrdListClass list;
+			OrdListClass greater;
+			map<KeyType, int> expected;
+
+			list.SetBalanceMode(modes[m], 0.7);
+			if (side == 1)
+			{
+				list.SetHashIndex(true, 0.5);
+				list.SetFilter(true, 0.01);
+				greater.SetHashIndex(true, 0.5);
+
+			}//end if
+
+			Fill(list, expected, 3000, 10000, rng);
+			for (map<KeyType, int>::iterator trav = expected.begin(); side == 1 && trav != expected.end(); ++trav)
+			{
+				string bytes = to_string(trav->first);
+
+				list.Find(trav->first);
+				list.SetPayload(bytes.data(), (int)bytes.size());
+
+			}//end for
+
+			for (int round = 0; round < 20; ++round)
+			{
+				KeyType key = (KeyType)(rng() % 11000) - 500;
+				map<KeyType, int> below(expected.begin(), expected.lower_bound(key));
+				map<KeyType, int> above(expected.lower_bound(key), expected.end());
+
+				list.Split(key, greater);
+				Check(SameKeys(list, below), test, "keys below " + to_string(key) + " stay");
+				Check(SameKeys(greater, above), test, "keys from " + to_string(key) + " move");
+
+				if (side == 1 && !above.empty())
+				{
+					greater.Find(above.begin()->first);
+					PayloadView bytes = greater.RetrievePayload();
+					Check(string(bytes.data, bytes.size) == to_string(above.begin()->first), test, "payload moves with its key");
+
+				}//end if
+
+				list.Join(greater);
+				Check(SameKeys(list, expected) && greater.IsEmpty(), test, "joined back at " + to_string(key));
+
+			}//end for
+
+			map<KeyType, int> overlap;
+			bool threw = false;
+
+			Fill(greater, overlap, 10, 10000, rng);
+			try
+			{
+				list.Join(greater);
+
+			}//end try
+
+			catch (KeyRangeOverlapException&)
+			{
+				threw = true;
+
+			}//end catch
+
+			Check(threw && SameKeys(list, expected) && SameKeys(greater, overlap), test, "overlapping ranges are refused");
+
+		}//end for
+
+	}//end for
+
+}//end TestSplitJoin
+
+
+//Pre: none
+//Post: Erase and EraseRange have been checked in every balance mode, with and without a hash index and filter,
+//		on ranges that are empty, reversed, cover one end of the list or all of it. the count returned and the
+//		keys left must match std::map, and a large range must leave a balanced tree
+void TestEraseRange()
+{
+	const string test = "EraseRange";
+	BalanceModeType modes[3] = { BALANCE_NONE, BALANCE_SCAPEGOAT, BALANCE_SPLAY };
+	mt19937 rng(42);
+
+	for (int m = 0; m < 3; ++m)
+	{
+		for (int side = 0; side < 2; ++side)
+		{
+			OrdListClass list;
+			map<KeyType, int> expected;
+
+			list.SetBalanceMode(modes[m], 0.7);
+			if (side == 1)
+			{
+				list.SetHashIndex(true, 0.5);
+				list.SetFilter(true, 0.01);
+
+			}//end if
+
+			for (int round = 0; round < 100; ++round)
+			{
+				Fill(list, expected, 300, 20000, rng);
+
+				KeyType low = (KeyType)(rng() % 22000) - 1000;
+				KeyType high = low + (KeyType)(rng() % 4000) - 200;
+				int removed = 0;
+
+				for (map<KeyType, int>::iterator trav = expected.lower_bound(low); trav != expected.end() && trav->first <= high; )
+				{
+					trav = expected.erase(trav);
+					++removed;
+
+				}//end for
+
+				Check(list.EraseRange(low, high) == removed, test, "count for [" + to_string(low) + ", " + to_string(high) + "]");
+				Check(SameKeys(list, expected), test, "keys left after [" + to_string(low) + ", " + to_string(high) + "]");
+
+				KeyType key = (KeyType)(rng() % 20000);
+				bool present = (expected.erase(key) > 0);
+				Check(list.Erase(key) == present, test, "Erase(" + to_string(key) + ")");
+
+			}//end for
+
+			Check(list.EraseRange(-1, 20000) == (int)expected.size() && list.IsEmpty(), test, "erase everything");
+
+		}//end for
+
+	}//end for
+
+	//a plain tree of sorted inserts is a chain, cutting most of it out leaves a complete tree
+
+	OrdListClass chain;
+	map<KeyType, int> expected;
+	ItemType item;
+
+	for (item.key = 0; item.key < 2000; ++item.key)
+	{
+		chain.Find(item.key);
+		chain.Insert(item);
+		if (item.key < 100 || item.key >= 1900)
+		{
+			expected[item.key] = 1;
+
+		}//end if
+
+	}//end for
+
+	Check(chain.EraseRange(100, 1899) == 1800 && SameKeys(chain, expected), test, "cut out of a chain");
+	Check(chain.Stats().height <= 8, test, "one rebalance after the cut");
+
+}//end TestEraseRange
+
+
+//Pre: none
+//Post: multiset mode has been checked in every balance mode: repeated Inserts raise the count of the key and
+//		Deletes drop one copy at a time, the counts survive copies, operator+, operator+=, Split and Join and
+//		the bulk loaders, expanded iteration visits every copy, and turning the mode off leaves one of each
+void TestMultiset()
+{
+	const string test = "Multiset";
+	BalanceModeType modes[3] = { BALANCE_NONE, BALANCE_SCAPEGOAT, BALANCE_SPLAY };
+	mt19937 rng(46);
+
+	for (int m = 0; m < 3; ++m)
+	{
+		OrdListClass list;
+		map<KeyType, int> expected;
+		ItemType item;
+
+		list.SetBalanceMode(modes[m], 0.7);
+		list.SetMultiset(true, false);
+
+		for (int i = 0; i < 20000; ++i)
+		{
+			item.key = (KeyType)(rng() % 500);
+			if (rng() % 3 != 0)
+			{
+				list.Find(item.key);
+				list.Insert(item);
+				++expected[item.key];
+
+			}//end if
+
+			else if (list.Find(item.key))
+			{
+				list.Delete();
+				if (--expected[item.key] == 0)
+				{
+					expected.erase(item.key);
+
+				}//end if
+
+			}//end else if
+
+		}//end for
+
+		Check(SameCounts(list, expected), test, "counts after inserts and deletes");
+
+		OrdListClass copy(list);
+		Check(copy == list && SameCounts(copy, expected), test, "copy keeps the counts");
+
+		map<KeyType, int> doubled = expected;
+		for (map<KeyType, int>::iterator trav = doubled.begin(); trav != doubled.end(); ++trav)
+		{
+			trav->second *= 2;
+
+		}//end for
+
+		OrdListClass sum = list + copy;
+		Check(SameCounts(sum, doubled), test, "operator+ adds the counts");
+		copy += list;
+		Check(SameCounts(copy, doubled), test, "operator+= adds the counts");
+
+		OrdListClass greater;
+		greater.SetMultiset(true, false);
+		list.Split(250, greater);
+		Check(SameCounts(greater, map<KeyType, int>(expected.lower_bound(250), expected.end())), test, "Split keeps the counts");
+		list.Join(greater);
+		Check(SameCounts(list, expected), test, "Join keeps the counts");
+
+		int copies = 0;
+		list.SetMultiset(true, true);
+		for (list.FirstPosition(); !list.EndOfList(); list.NextPosition())
+		{
+			++copies;
+
+		}//end for
+
+		int total = 0;
+		for (map<KeyType, int>::iterator trav = expected.begin(); trav != expected.end(); ++trav)
+		{
+			total += trav->second;
+
+		}//end for
+
+		Check(copies == total, test, "expanded iteration visits every copy");
+
+		KeyType key = expected.begin()->first;
+		Check(list.Erase(key) && list.Count(key) == 0, test, "Erase removes every copy");
+		expected.erase(key);
+
+		list.SetMultiset(false, false);
+		for (map<KeyType, int>::iterator trav = expected.begin(); trav != expected.end(); ++trav)
+		{
+			trav->second = 1;
+
+		}//end for
+
+		Check(SameCounts(list, expected), test, "turning the mode off leaves one copy of each");
+
+	}//end for
+
+	//the bulk loaders make one node of every run of equal keys
+
+	OrdListClass loaded;
+	ItemType sorted[7] = { { 1 }, { 1 }, { 2 }, { 5 }, { 5 }, { 5 }, { 9 } };
+	ItemType unsorted[6] = { { 4 }, { 1 }, { 4 }, { 4 }, { 2 }, { 1 } };
+	map<KeyType, int> runs;
+
+	loaded.SetMultiset(true, false);
+	loaded.BuildFromSorted(sorted, 7, false);
+	runs[1] = 2;
+	runs[2] = 1;
+	runs[5] = 3;
+	runs[9] = 1;
+	Check(SameCounts(loaded, runs), test, "BuildFromSorted counts runs");
+
+	loaded.BulkLoad(unsorted, 6, DUPLICATE_ERROR);
+	runs.clear();
+	runs[1] = 2;
+	runs[2] = 1;
+	runs[4] = 3;
+	Check(SameCounts(loaded, runs), test, "BulkLoad counts runs");
+
+}//end TestMultiset
+
+
+//Pre: none
+//Post: DumpFile and LoadFile have been checked in every balance mode, with and without a hash index and filter:
+//		a dumped list loads back into the same keys and a tree no deeper (the same tree when it is shallow),
+//		a sorted file loads balanced, and a file
+//		that can not be read, holds something other than keys or repeats a key is refused with the list left
+//		as it was
+void TestFileRoundTrip()
+{
+	const string test = "DumpFile/LoadFile";
+	const string fileName = ScratchName("ordlist_tests.tmp");
+	BalanceModeType modes[3] = { BALANCE_NONE, BALANCE_SCAPEGOAT, BALANCE_SPLAY };
+	mt19937 rng(48);
+
+	for (int m = 0; m < 3; ++m)
+	{
+		for (int side = 0; side < 2; ++side)
+		{
+			OrdListClass list;
+			OrdListClass loaded;
+			map<KeyType, int> expected;
+
+			list.SetBalanceMode(modes[m], 0.7);
+			loaded.SetBalanceMode(modes[m], 0.7);
+			if (side == 1)
+			{
+				loaded.SetHashIndex(true, 0.5);
+				loaded.SetFilter(true, 0.01);
+
+			}//end if
+
+			Fill(list, expected, 20000, 1000000, rng);
+			list.DumpFile(fileName);
+			loaded.LoadFile(fileName);
+
+			ListStats before = list.Stats();
+			ListStats after = loaded.Stats();
+			Check(SameKeys(loaded, expected) && loaded == list, test, "keys load back");
+			Check(after.height <= before.height, test, "the tree loads back no deeper");
+
+			//a scapegoat tree is shallow enough to be rebuilt as it was, a random plain tree may be too deep
+			//and is then loaded balanced
+			Check(modes[m] != BALANCE_SCAPEGOAT || before.depthHistogram == after.depthHistogram, test, "the same tree loads back");
+
+			//every way a load can fail leaves what was loaded before
+
+			ofstream outdat;
+			bool threw = false;
+
+			outdat.open(fileName);
+			outdat << "5 3 8 3" << endl;
+			outdat.close();
+			try
+			{
+				loaded.LoadFile(fileName);
+
+			}//end try
+
+			catch (DuplicateKeyException&)
+			{
+				threw = true;
+
+			}//end catch
+
+			Check(threw && SameKeys(loaded, expected), test, "a repeated key is refused");
+
+			threw = false;
+			outdat.open(fileName);
+			outdat << "5 3 eight" << endl;
+			outdat.close();
+			try
+			{
+				loaded.LoadFile(fileName);
+
+			}//end try
+
+			catch (FileException&)
+			{
+				threw = true;
+
+			}//end catch
+
+			Check(threw && SameKeys(loaded, expected), test, "a file of something other than keys is refused");
+
+			threw = false;
+			try
+			{
+				loaded.LoadFile(ScratchName("ordlist_tests_missing.tmp"));
+
+			}//end try
+
+			catch (FileException&)
+			{
+				threw = true;
+
+			}//end catch
+
+			Check(threw && SameKeys(loaded, expected), test, "a missing file is refused");
+
+		}//end for
+
+	}//end for
+
+	//sorted keys are the preorder of a chain, which is loaded balanced instead
+
+	OrdListClass sorted;
+	map<KeyType, int> expected;
+	ofstream outdat(fileName);
+
+	for (KeyType key = 0; key < 5000; ++key)
+	{
+		outdat << key << endl;
+		expected[key] = 1;
+
+	}//end for
+
+	outdat.close();
+	sorted.LoadFile(fileName);
+	Check(SameKeys(sorted, expected) && sorted.Stats().height <= 14, test, "a sorted file loads balanced");
+
+	remove(fileName.c_str());
+
+}//end TestFileRoundTrip
+
+
+//Pre: none
+//Post: returns true to the caller if list holds exactly the keys of expected, in order
+bool SameDiskKeys(	/*inout*/DiskListClass& list,			//list to compare
+					/*in*/const set<KeyType>& expected)		//keys it should hold
+{
+	visited.clear();
+	list.PrintScreen(Collect);
+	return list.ReturnLength() == (int)expected.size() && visited == vector<KeyType>(expected.begin(), expected.end());
+
+}//end SameDiskKeys
+
+
+//Pre: none
+//Post: DiskListClass has been checked against std::set over enough keys for a tree of several levels: Find,
+//		Insert and Delete agree with the set, Delete leaves the cursor on the next key, a repeated key is
+//		refused, and emptying the leaves takes the tree back down to one level
+void TestDiskList()
+{
+	const string test = "DiskList";
+	DiskListClass list(ScratchName("ordlist_tests_disk.tmp"), 16, nullptr);
+	set<KeyType> expected;
+	mt19937 rng(50);
+	ItemType item;
+
+	for (item.key = 0; item.key < 100000; ++item.key)
+	{
+		list.Find(item.key);
+		list.Insert(item);
+		expected.insert(item.key);
+
+	}//end for
+
+	int fullHeight = list.ReturnHeight();
+	Check(fullHeight > 1 && SameDiskKeys(list, expected), test, "sorted inserts");
+
+	bool threw = false;
+	try
+	{
+		item.key = 500;
+		list.Find(item.key);
+		list.Insert(item);
+
+	}//end try
+
+	catch (DuplicateKeyException&)
+	{
+		threw = true;
+
+	}//end catch
+
+	Check(threw && SameDiskKeys(list, expected), test, "a repeated key is refused");
+
+	for (int round = 0; round < 200000; ++round)
+	{
+		item.key = (KeyType)(rng() % 120000);
+		bool found = list.Find(item.key);
+
+		if (found != (expected.count(item.key) > 0))
+		{
+			Check(false, test, "Find(" + to_string(item.key) + ")");
+			break;
+
+		}//end if
+
+		if (found)
+		{
+			set<KeyType>::iterator next = expected.upper_bound(item.key);
+
+			list.Delete();
+			expected.erase(item.key);
+			if (next != expected.end() && list.Retrieve().key != *next)
+			{
+				Check(false, test, "Delete(" + to_string(item.key) + ") leaves the cursor on the next key");
+				break;
+
+			}//end if
+
+		}//end if
+
+		else
+		{
+			list.Insert(item);
+			expected.insert(item.key);
+
+		}//end else
+
+	}//end for
+
+	Check(SameDiskKeys(list, expected), test, "random inserts and deletes");
+
+	//empty leaves are unlinked and their pages released, so the tree shrinks as it empties
+
+	vector<KeyType> keys(expected.begin(), expected.end());
+	for (size_t i = 0; i + 1 < keys.size(); ++i)
+	{
+		list.Find(keys[i]);
+		list.Delete();
+		expected.erase(keys[i]);
+
+	}//end for
+
+	Check(SameDiskKeys(list, expected) && list.ReturnHeight() == 1, test, "one key left in one leaf");
+
+	list.Find(keys.back());
+	list.Delete();
+	expected.clear();
+	Check(SameDiskKeys(list, expected) && list.IsEmpty(), test, "every key deleted");
+
+}//end TestDiskList
+
+
+//Pre: none
+//Post: LsmListClass has been checked against std::set with buffers from one write to many, so that writes
+//		land in the buffer, in frozen runs and in merged runs: Find agrees with the set after every write, the
+//		newest write of a key wins, and Export before and after Compact holds exactly the live keys
+void TestLsmList()
+{
+	const string test = "LsmList";
+	int bufferSizes[4] = { 1, 7, 100, 5000 };
+	mt19937 rng(47);
+
+	for (int b = 0; b < 4; ++b)
+	{
+		LsmListClass list(bufferSizes[b], 0.01, nullptr);
+		map<KeyType, int> expected;
+		ItemType item;
+		bool agrees = true;
+
+		for (int round = 0; round < 50000 && agrees; ++round)
+		{
+			KeyType key = (KeyType)(rng() % 3000);
+			int op = (int)(rng() % 10);
+
+			if (op < 6)
+			{
+				item.key = key;
+				list.Insert(item);
+				expected[key] = 1;
+
+			}//end if
+
+			else if (op < 8)
+			{
+				list.Delete(key);
+				expected.erase(key);
+
+			}//end else if
+
+			else
+			{
+				agrees = (list.Find(key, item) == (expected.count(key) > 0));
+				agrees = agrees && (expected.count(key) == 0 || item.key == key);
+				Check(agrees, test, "Find(" + to_string(key) + ") with a buffer of " + to_string(bufferSizes[b]));
+
+			}//end else
+
+		}//end for
+
+		OrdListClass exported;
+		list.Export(exported);
+		Check(SameKeys(exported, expected), test, "Export with a buffer of " + to_string(bufferSizes[b]));
+
+		list.Compact();
+		agrees = (list.ReturnRunCount() <= 1 && list.ReturnBufferCount() == 0);
+		for (KeyType key = -1; key <= 3000 && agrees; ++key)
+		{
+			agrees = (list.Find(key, item) == (expected.count(key) > 0));
+
+		}//end for
+
+		list.Export(exported);
+		Check(agrees && SameKeys(exported, expected), test, "Compact with a buffer of " + to_string(bufferSizes[b]));
+
+	}//end for
+
+}//end TestLsmList
@@ -0,0 +1,331 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: ThreadPool.cpp
+Purpose: Provides the implementation for a work stealing thread pool used by the parallel traversals of OrdListClass.
+Input: All input is done via client
+Output: none
+Assumptions: A single pool may be shared by any number of lists.
+*/
+
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+//index of the queue owned by the current thread. -1 for threads that are not workers of any pool
+static thread_local int workerIndex = -1;
+
+//pool that owns the current worker thread
+static thread_local ThreadPoolClass* workerPool = nullptr;
+
+static mutex defaultLock;				//guards the default pool
+static ThreadPoolClass* defaultPool = nullptr;
+static int defaultSize = 0;				//0 = one worker per hardware thread
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: a new pool with numThreads workers has been created. numThreads <= 0 uses one worker per hardware thread
+ThreadPoolClass::ThreadPoolClass(/*in*/int numThreads) //number of worker threads
+	: queued(0), idle(0), nextQueue(0), stop(false)
+{
+	if (numThreads <= 0)
+	{
+		numThreads = (int)thread::hardware_concurrency();
+
+		if (numThreads <= 0)
+		{
+			numThreads = 1;
+
+		}//end if
+
+	}//end if
+
+	for (int i = 0; i < numThreads; ++i)
+	{
+		queues.push_back(new WorkQueue);
+
+	}//end for
+
+	for (int i = 0; i < numThreads; ++i)
+	{
+		workers.push_back(thread(&ThreadPoolClass::WorkerLoop, this, i));
+
+	}//end for
+
+}//end constructor
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated, no group is still being waited on
+//Post: all workers have been stopped and joined
+ThreadPoolClass::~ThreadPoolClass()
+{
+	{
+		lock_guard<mutex> guard(sleepLock);
+		stop = true;
+	}
+	wake.notify_all();
+
+	for (size_t i = 0; i < workers.size(); ++i)
+	{
+		workers[i].join();
+
+	}//end for
+
+	for (size_t i = 0; i < queues.size(); ++i)
+	{
+		delete queues[i];
+
+	}//end for
+
+}//end destructor
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated
+//Post: returns the number of worker threads to the caller
+int ThreadPoolClass::ReturnSize() const
+{
+	return (int)workers.size();
+
+}//end ReturnSize
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated
+//Post: task has been queued and counted against group
+void ThreadPoolClass::Spawn(/*inout*/TaskGroup& group,	//group the task belongs to
+							/*in*/TaskType task)		//work to run
+{
+	//workers push onto their own queue so that the work stays local, everyone else spreads it round robin
+
+	int target = workerIndex;
+	if (workerPool != this || target < 0)
+	{
+		target = (int)(nextQueue++ % queues.size());
+
+	}//end if
+
+	group.pending++;
+	{
+		lock_guard<mutex> guard(queues[target]->lock);
+		Task temp = { task, &group };
+		queues[target]->tasks.push_back(temp);
+	}
+	queued++;
+
+	if (idle.load() > 0)
+	{
+		lock_guard<mutex> guard(sleepLock);
+		wake.notify_one();
+
+	}//end if
+
+}//end Spawn
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated
+//Post: every task of group has finished. The caller runs queued tasks while it waits
+//Exceptions thrown: rethrows the first exception thrown by a task of the group
+void ThreadPoolClass::Wait(/*inout*/TaskGroup& group) //group to wait on
+{
+	int self = (workerPool == this) ? workerIndex : -1;
+
+	while (group.pending.load() > 0)
+	{
+		if (!RunOne(self))
+		{
+			this_thread::yield();
+
+		}//end if
+
+	}//end while
+
+	if (group.error)
+	{
+		exception_ptr temp = group.error;
+		group.error = nullptr;
+		rethrow_exception(temp);
+
+	}//end if
+
+}//end Wait
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated
+//Post: returns true to the caller if a worker is idle and no task is queued
+bool ThreadPoolClass::IsHungry() const
+{
+	return (idle.load(memory_order_relaxed) > 0 && queued.load(memory_order_relaxed) == 0);
+
+}//end IsHungry
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: returns the process wide pool shared by every list that was not given a pool of its own
+ThreadPoolClass* ThreadPoolClass::Default()
+{
+	//never deleted on purpose, workers may still be parked when static destructors run
+
+	lock_guard<mutex> guard(defaultLock);
+	if (defaultPool == nullptr)
+	{
+		defaultPool = new ThreadPoolClass(defaultSize);
+
+	}//end if
+
+	return defaultPool;
+
+}//end Default
+
+
+/*****************************************************************************************************/
+
+//Pre: none
+//Post: sets the number of workers of the default pool. Only has an effect before the default pool is first used
+void ThreadPoolClass::SetDefaultSize(/*in*/int numThreads) //number of worker threads
+{
+	lock_guard<mutex> guard(defaultLock);
+	defaultSize = numThreads;
+
+}//end SetDefaultSize
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated, self is the queue of the calling worker (-1 for outside threads)
+//Post: runs one queued task, own queue first, then stolen from the others. returns false if none was found
+bool ThreadPoolClass::RunOne(/*in*/int self) //index of the calling worker
+{
+	Task temp = { nullptr, nullptr };
+	bool found = false;
+	int numQueues = (int)queues.size();
+
+	if (queued.load() == 0)
+	{
+		return false;
+
+	}//end if
+
+	//newest task from our own queue (still warm in cache)
+	if (self >= 0)
+	{
+		lock_guard<mutex> guard(queues[self]->lock);
+		if (!queues[self]->tasks.empty())
+		{
+			temp = queues[self]->tasks.back();
+			queues[self]->tasks.pop_back();
+			found = true;
+
+		}//end if
+
+	}//end if
+
+	//oldest task of somebody else (the largest piece of work they have)
+	for (int i = 1; i <= numQueues && !found; ++i)
+	{
+		int victim = (self + i + numQueues) % numQueues;
+		lock_guard<mutex> guard(queues[victim]->lock);
+		if (!queues[victim]->tasks.empty())
+		{
+			temp = queues[victim]->tasks.front();
+			queues[victim]->tasks.pop_front();
+			found = true;
+
+		}//end if
+
+	}//end for
+
+	if (!found)
+	{
+		return false;
+
+	}//end if
+
+	queued--;
+
+	try
+	{
+		temp.work();
+
+	}//end try
+
+	catch (...)
+	{
+		lock_guard<mutex> guard(temp.group->errorLock);
+		if (!temp.group->error)
+		{
+			temp.group->error = current_exception();
+
+		}//end if
+
+	}//end catch
+
+	temp.group->pending--;
+	return true;
+
+}//end RunOne
+
+
+/*****************************************************************************************************/
+
+//Pre: ThreadPoolClass has been instantiated
+//Post: body of every worker thread. returns once the pool is stopped
+void ThreadPoolClass::WorkerLoop(/*in*/int self) //index of this worker
+{
+	workerIndex = self;
+	workerPool = this;
+
+	while (!stop.load())
+	{
+		if (!RunOne(self))
+		{
+			unique_lock<mutex> guard(sleepLock);
+			idle++;
+			wake.wait(guard, [this] { return stop.load() || queued.load() > 0; });
+			idle--;
+
+		}//end if
+
+	}//end while
+
+}//end WorkerLoop
+
+
+/*****************************************************************************************************/
+
+//Pre: pool and group are still alive
+//Post: every task of group has finished. errors of the tasks are dropped here, a normal Wait before this
+//		point has already reported them
+WaitGuard::~WaitGuard()
+{
+	if (group->pending.load() > 0)
+	{
+		try
+		{
+			pool->Wait(*group);
+
+		}//end try
+
+		catch (...)
+		{
+			//the caller is already unwinding with an exception of its own
+
+		}//end catch
+
+	}//end if
+
+}//end WaitGuard destructor
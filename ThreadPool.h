@@ -0,0 +1,201 @@
+/*
+Author: John Lahut
+Date: 10/18/2026
+Project: OrdList as a BST
+Filename: ThreadPool.h
+Purpose: Provides the specification for a work stealing thread pool used by the parallel traversals of OrdListClass.
+		Every worker owns a queue of tasks. A worker pops from the back of its own queue and, when that is empty,
+		steals from the front of another worker's queue. A thread that waits on a TaskGroup runs queued tasks
+		while it waits, so tasks may spawn and wait on other tasks without deadlocking the pool.
+Input: All input is done via client
+Output: none
+Assumptions: A single pool may be shared by any number of lists. Tasks must not throw pointers they expect to be freed.
+*/
+
+#ifndef THREAD_POOL
+#define THREAD_POOL
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+typedef function<void()> TaskType;
+
+//Counts the outstanding tasks of one fork/join. The first exception thrown by a task is kept and rethrown by Wait
+struct TaskGroup
+{
+	atomic<int> pending;		//tasks spawned but not yet finished
+	mutex errorLock;			//guards error
+	exception_ptr error;		//first exception thrown by a task in the group
+
+	TaskGroup() : pending(0) {}
+};
+
+/*
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Public Methods				 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+ThreadPoolClass(int numThreads);
+	a new pool with numThreads workers has been created. numThreads <= 0 uses one worker per hardware thread
+
+~ThreadPoolClass();
+	all workers have been stopped and joined
+
+int ReturnSize() const;
+	returns the number of worker threads to the caller
+
+void Spawn(TaskGroup& group, TaskType task);
+	task has been queued and counted against group
+
+void Wait(TaskGroup& group);
+	every task of group has finished. The caller runs queued tasks while it waits
+
+bool IsHungry() const;
+	returns true to the caller if a worker is idle and no task is queued
+
+static ThreadPoolClass* Default();
+	returns the process wide pool shared by every list that was not given a pool of its own
+
+static void SetDefaultSize(int numThreads);
+	sets the number of workers of the default pool. Only has an effect before the default pool is first used
+
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+~                                            ~
+~              Protected Methods			 ~
+~                                            ~
+~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+bool RunOne(int self);
+	runs one queued task, own queue first, then stolen from the others. returns false if none was found
+
+void WorkerLoop(int self);
+	body of every worker thread
+*/
+
+class ThreadPoolClass
+{
+
+public:
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: a new pool with numThreads workers has been created. numThreads <= 0 uses one worker per hardware thread
+	ThreadPoolClass(/*in*/int numThreads); //number of worker threads
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated, no group is still being waited on
+	//Post: all workers have been stopped and joined
+	~ThreadPoolClass();
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated
+	//Post: returns the number of worker threads to the caller
+	int ReturnSize() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated
+	//Post: task has been queued and counted against group
+	void Spawn(	/*inout*/TaskGroup& group,	//group the task belongs to
+				/*in*/TaskType task);		//work to run
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated
+	//Post: every task of group has finished. The caller runs queued tasks while it waits
+	//Exceptions thrown: rethrows the first exception thrown by a task of the group
+	void Wait(/*inout*/TaskGroup& group); //group to wait on
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated
+	//Post: returns true to the caller if a worker is idle and no task is queued
+	bool IsHungry() const;
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: returns the process wide pool shared by every list that was not given a pool of its own
+	static ThreadPoolClass* Default();
+
+	/*****************************************************************************************************/
+
+	//Pre: none
+	//Post: sets the number of workers of the default pool. Only has an effect before the default pool is first used
+	static void SetDefaultSize(/*in*/int numThreads); //number of worker threads
+
+	/*****************************************************************************************************/
+
+protected:
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated, self is the queue of the calling worker (-1 for outside threads)
+	//Post: runs one queued task, own queue first, then stolen from the others. returns false if none was found
+	bool RunOne(/*in*/int self); //index of the calling worker
+
+	/*****************************************************************************************************/
+
+	//Pre: ThreadPoolClass has been instantiated
+	//Post: body of every worker thread. returns once the pool is stopped
+	void WorkerLoop(/*in*/int self); //index of this worker
+
+	/*****************************************************************************************************/
+
+private:
+
+	struct Task
+	{
+		TaskType work;		//function to run
+		TaskGroup* group;	//group to notify when done
+	};
+
+	struct WorkQueue
+	{
+		mutex lock;			//guards tasks
+		deque<Task> tasks;	//owner uses the back, thieves use the front
+	};
+
+	vector<WorkQueue*> queues;		//one queue per worker
+	vector<thread> workers;			//worker threads
+	atomic<int> queued;				//tasks sitting in any queue
+	atomic<int> idle;				//workers currently asleep
+	atomic<unsigned> nextQueue;		//round robin target for tasks spawned outside the pool
+	atomic<bool> stop;				//set by the destructor
+	mutex sleepLock;				//guards wake
+	condition_variable wake;		//signalled when work arrives
+
+};
+
+//Waits on a group when it goes out of scope, so a fork/join that throws on the calling thread does not unwind the
+//stack its tasks still point into. Declare it after the group and everything the tasks use. On that path the
+//errors of the tasks are dropped and the exception already unwinding is the one the caller sees
+struct WaitGuard
+{
+	ThreadPoolClass* pool;		//pool the tasks run on
+	TaskGroup* group;			//group to wait on
+
+	WaitGuard(ThreadPoolClass* pool, TaskGroup& group) : pool(pool), group(&group) {}
+	~WaitGuard();
+
+private:
+
+	WaitGuard(const WaitGuard&);
+	void operator=(const WaitGuard&);
+};
+
+#endif